@@ -1,5 +1,17 @@
 #include "ButtonManager.h"
 #include "config.h"
+#include "feedback.h"
+
+// Index order of state[] and the ISRs
+static const uint8_t BUTTON_PINS[4] = { BUTTON_UP_PIN, BUTTON_DOWN_PIN, BUTTON_SELECT_PIN, BUTTON_BACK_PIN };
+static const Button BUTTON_EVENTS[4] = { UP, DOWN, SELECT, BACK };
+static const uint8_t BUTTON_INDEX_SELECT = 2;
+static const uint8_t BUTTON_INDEX_BACK = 3;
+
+ButtonManager::ButtonEdge ButtonManager::queue[BUTTON_QUEUE_SIZE];
+volatile uint8_t ButtonManager::queueHead = 0;
+volatile uint8_t ButtonManager::queueTail = 0;
+volatile uint16_t ButtonManager::droppedEdges = 0;
 
 void ButtonManager::begin() {
     pinMode(BUTTON_UP_PIN, INPUT_PULLUP);
@@ -7,47 +19,121 @@ void ButtonManager::begin() {
     pinMode(BUTTON_SELECT_PIN, INPUT_PULLUP);
     pinMode(BUTTON_BACK_PIN, INPUT_PULLUP);
 
-    pinMode(BUZZER_PIN, OUTPUT);
-    digitalWrite(BUZZER_PIN, LOW);
+    resume();
 }
 
-Button ButtonManager::readButton() {
-    unsigned long currentTime = millis();
+void ButtonManager::suspend() {
+    detachInterrupt(digitalPinToInterrupt(BUTTON_UP_PIN));
+    detachInterrupt(digitalPinToInterrupt(BUTTON_DOWN_PIN));
+    detachInterrupt(digitalPinToInterrupt(BUTTON_SELECT_PIN));
+    detachInterrupt(digitalPinToInterrupt(BUTTON_BACK_PIN));
+}
 
-    if (currentTime - lastDebounceTime < debounceDelay) {
-        return NONE;
-    }
+// Edges missed in between are recovered by readButton() re-reading the pins
+void ButtonManager::resume() {
+    attachInterrupt(digitalPinToInterrupt(BUTTON_UP_PIN), isrUp, CHANGE);
+    attachInterrupt(digitalPinToInterrupt(BUTTON_DOWN_PIN), isrDown, CHANGE);
+    attachInterrupt(digitalPinToInterrupt(BUTTON_SELECT_PIN), isrSelect, CHANGE);
+    attachInterrupt(digitalPinToInterrupt(BUTTON_BACK_PIN), isrBack, CHANGE);
+}
 
-    if (digitalRead(BUTTON_UP_PIN) == LOW) {
-        lastDebounceTime = currentTime;
-        handleBuzzer();
-        return UP;
+// ===== Interrupt side =====
+
+// A full queue drops the edge; readButton() re-reads the pins once the
+// debounce window passes, so the level is never lost for long
+void IRAM_ATTR ButtonManager::pushEdge(uint8_t index) {
+    uint8_t head = queueHead;
+    if ((uint8_t)(head - queueTail) >= BUTTON_QUEUE_SIZE) {
+        droppedEdges++;
+        return;
     }
+    ButtonEdge& edge = queue[head & (BUTTON_QUEUE_SIZE - 1)];
+    edge.index = index;
+    edge.pressed = digitalRead(BUTTON_PINS[index]) == LOW;
+    edge.time = millis();
+    queueHead = head + 1;  // Publish only after the slot is written
+}
+
+void IRAM_ATTR ButtonManager::isrUp() { pushEdge(0); }
+void IRAM_ATTR ButtonManager::isrDown() { pushEdge(1); }
+void IRAM_ATTR ButtonManager::isrSelect() { pushEdge(2); }
+void IRAM_ATTR ButtonManager::isrBack() { pushEdge(3); }
+
+uint16_t ButtonManager::getDroppedEdges() {
+    return droppedEdges;
+}
+
+// ===== Loop side =====
 
-    if (digitalRead(BUTTON_DOWN_PIN) == LOW) {
-        lastDebounceTime = currentTime;
-        handleBuzzer();
-        return DOWN;
+Button ButtonManager::readButton() {
+    // Drain edges until one makes a press; the rest wait for the next call
+    while (queueTail != queueHead) {
+        ButtonEdge edge = queue[queueTail & (BUTTON_QUEUE_SIZE - 1)];
+        queueTail = queueTail + 1;
+
+        Button btn = applyEdge(edge.index, edge.pressed, edge.time);
+        if (btn != NONE) {
+            return btn;
+        }
     }
 
-    if (digitalRead(BUTTON_SELECT_PIN) == LOW) {
-        lastDebounceTime = currentTime;
-        handleBuzzer();
-        return SELECT;
+    return pollHeld(millis());
+}
+
+// Leading-edge debounce: the first edge counts at once, anything inside
+// BUTTON_DEBOUNCE_MS after it is contact bounce
+Button ButtonManager::applyEdge(uint8_t index, bool pressed, unsigned long time) {
+    ButtonState& button = state[index];
+    if (time - button.changeTime < BUTTON_DEBOUNCE_MS || pressed == button.pressed) {
+        return NONE;
     }
 
-    if (digitalRead(BUTTON_BACK_PIN) == LOW) {
-        lastDebounceTime = currentTime;
-        handleBuzzer();
-        return BACK;
+    button.pressed = pressed;
+    button.changeTime = time;
+    if (!pressed) {
+        return NONE;
     }
 
-    return NONE;
+    button.longReported = false;
+    button.nextRepeat = time + BUTTON_REPEAT_DELAY_MS;
+    feedback.play(FEEDBACK_CLICK);
+    return BUTTON_EVENTS[index];
 }
 
-void ButtonManager::handleBuzzer() {
-    if (!isBuzzerEnabled) return;
-    digitalWrite(BUZZER_PIN, HIGH);
-    delay(20);
-    digitalWrite(BUZZER_PIN, LOW);
-}
\ No newline at end of file
+// Repeats, long presses, and edges swallowed as bounce or by a full queue
+Button ButtonManager::pollHeld(unsigned long now) {
+    for (uint8_t i = 0; i < 4; i++) {
+        ButtonState& button = state[i];
+        if (now - button.changeTime < BUTTON_DEBOUNCE_MS) {
+            continue;
+        }
+
+        bool level = digitalRead(BUTTON_PINS[i]) == LOW;
+        if (level != button.pressed) {
+            Button btn = applyEdge(i, level, now);
+            if (btn != NONE) {
+                return btn;
+            }
+            continue;
+        }
+        if (!button.pressed) {
+            continue;
+        }
+
+        unsigned long held = now - button.changeTime;
+        if (i == BUTTON_INDEX_BACK || i == BUTTON_INDEX_SELECT) {
+            if (!button.longReported && held >= BUTTON_LONG_PRESS_MS) {
+                button.longReported = true;
+                return i == BUTTON_INDEX_BACK ? BACK_LONG : SELECT_LONG;
+            }
+        } else if (BUTTON_EVENTS[i] == UP || BUTTON_EVENTS[i] == DOWN) {
+            if ((long)(now - button.nextRepeat) >= 0) {
+                // From now, not from the missed slot - a slow pass must not
+                // turn into a burst of repeats
+                button.nextRepeat = now + (held >= BUTTON_REPEAT_FAST_AFTER_MS ? BUTTON_REPEAT_FAST_MS : BUTTON_REPEAT_MS);
+                return BUTTON_EVENTS[i];
+            }
+        }
+    }
+    return NONE;
+}
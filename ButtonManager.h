@@ -8,18 +8,56 @@ enum Button {
     UP,
     DOWN,
     SELECT,
-    BACK
+    BACK,
+    BACK_LONG,  // BACK held for BUTTON_LONG_PRESS_MS, after the BACK itself
+    SELECT_LONG // Likewise for SELECT
 };
 
+// Pin-change interrupts queue every edge with its time; readButton() turns
+// them into presses with per-button debounce. UP/DOWN repeat while held,
+// BACK and SELECT report a long press once.
 class ButtonManager {
 public:
     void begin();
-    Button readButton();
-    void handleBuzzer();
+    Button readButton();    // At most one event per call, NONE when idle
+
+    // Edge interrupts off and back on, around light sleep
+    void suspend();
+    void resume();
+
+    static uint16_t getDroppedEdges();
 
 private:
-    unsigned long lastDebounceTime = 0;
-    const unsigned long debounceDelay = 200; // milliseconds
+    struct ButtonState {
+        bool pressed;                   // Debounced level
+        bool longReported;
+        unsigned long changeTime;       // Last accepted edge
+        unsigned long nextRepeat;
+    };
+
+    Button applyEdge(uint8_t index, bool pressed, unsigned long time);
+    Button pollHeld(unsigned long now);
+
+    ButtonState state[4] = {};
+
+    // Single producer (the ISRs) / single consumer (readButton) ring. Only
+    // the ISRs move head and only readButton() moves tail, so no locking.
+    struct ButtonEdge {
+        uint8_t index;
+        bool pressed;
+        unsigned long time;
+    };
+
+    static void pushEdge(uint8_t index);
+    static void isrUp();
+    static void isrDown();
+    static void isrSelect();
+    static void isrBack();
+
+    static ButtonEdge queue[];
+    static volatile uint8_t queueHead;
+    static volatile uint8_t queueTail;
+    static volatile uint16_t droppedEdges;
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -4,17 +4,27 @@
 #include <Wire.h>
 #include <ESP8266WiFi.h>
 #include "wifi.h" // Include the WiFi functionalities
+#include "telemetry.h"
+#include "frame_pacer.h"
+#include "screen.h"
+#include "feedback.h"
+#include "power.h"
+#include "saved_networks.h"
+#include "journal.h"
+#include "monitor.h"
+#include "deauth_detector.h"
+#include "channel_analyzer.h"
 
-// Enum to keep track of the current screen
-enum Screen {
+// Enum to keep track of the current menu. Everything opened from a menu
+// is a Screen on the screen stack, drawn over it until it closes.
+enum MenuScreen {
     MAIN_MENU,
     WIFI_MENU,
     DEAUTH_MENU,
-    SETTINGS_MENU,
-    SHOW_SAVED_NETWORKS
+    SETTINGS_MENU
 };
 
-Screen currentScreen = MAIN_MENU; // Start at the main menu
+MenuScreen currentScreen = MAIN_MENU; // Start at the main menu
 int currentMenuIndex = 0;         // Current selected index
 MainMenu OledDisplay;             // OLED display object
 ButtonManager buttons;            // Button manager for button presses
@@ -25,57 +35,67 @@ WifiMenu wifiMenu;  // Create WifiMenu object to handle WiFi functionalities
 void showCurrentScreen(bool withTransition = false);
 void handleSelection(int selectedIndex);
 void handleWiFiSelection(int selectedIndex);
+void handleDeauthSelection(int selectedIndex);
+void handleSettingsSelection(int selectedIndex);
 int getCurrentMenuCount();
+void debugSavedNetworks();
 
 // ==========================
 // Initialization
 // ==========================
 void setup() {
     Serial.begin(115200);
-    EEPROM.begin(512);
-    wifiMenu.initializeEEPROM();
-    debugEEPROM();
+    telemetry.begin();    // Boot heap baseline, before anything else allocates
     Serial.println("Starting.....");
     OledDisplay.begin();  // Initialize OLED
+    feedback.begin();     // Buzzer and status LED, off
     buttons.begin();      // Initialize button manager
+    bool storageOk = wifiMenu.begin();  // Size scan storage from the heap that is left
+    power.begin(buttons); // Radio off until the first scan
+
+    // Saved networks and settings from the last run
+    journal.attach(savedNetworks);
+    journal.attach(wifiMenu);
+    journal.attach(power);
+    journal.attach(feedback);
+    journal.attach(deauthDetector);
+    journal.begin();
+    debugSavedNetworks();
 
     // Show the main menu on the screen
     showCurrentScreen(true);
+
+    // WiFi Scan refuses to run for the rest of the session; say why up front
+    if (!storageOk) {
+        messageScreen.open(F("No memory for\nscan results"), 3000, -1, -1);
+        feedback.play(FEEDBACK_ERROR);
+    }
 }
 
 // ==========================
-// Debug EEPROM
+// Debug Saved Networks
 // ==========================
 // Add this to your setup() function or call it from a menu option:
-void debugEEPROM() {
-  Serial.println(F("======= EEPROM DEBUG ======="));
+void debugSavedNetworks() {
+  Serial.println(F("===== SAVED NETWORKS ======="));
   
-  // Check the network count first
-  uint8_t count = EEPROM.read(EEPROM_START_ADDR);
   Serial.print(F("Saved network count: "));
-  Serial.println(count);
+  Serial.println(savedNetworks.count());
   
-  if (count > MAX_NETWORKS) {
-    Serial.println(F("WARNING: Count exceeds maximum! Possible corruption."));
-  }
-  
-  // Try to read each network
-  for (int i = 0; i < count && i < MAX_NETWORKS; i++) {
+  for (int i = 0; i < savedNetworks.count(); i++) {
+    const SavedNetwork& net = savedNetworks.get(i);
+    char bssid[18];
+    formatBssid(net.bssid, bssid);
+    
     Serial.print(F("Network #"));
     Serial.print(i);
     Serial.println(F(":"));
-    
-    String ssid, bssid;
-    bool success = wifiMenu.getSavedNetwork(i, ssid, bssid);
-    
-    if (success) {
-      Serial.print(F("  SSID: "));
-      Serial.println(ssid);
-      Serial.print(F("  BSSID: "));
-      Serial.println(bssid);
-    } else {
-      Serial.println(F("  ERROR: Failed to read network!"));
-    }
+    Serial.print(F("  SSID: "));
+    Serial.println(net.ssid);
+    Serial.print(F("  BSSID: "));
+    Serial.print(bssid);
+    Serial.print(F("  CH: "));
+    Serial.println(net.channel);
   }
   
   Serial.println(F("============================"));
@@ -101,9 +121,6 @@ void showCurrentScreen(bool withTransition) {
         case SETTINGS_MENU:
             OledDisplay.showSubMenu("Settings", settingSubMenuItems, settingSubMenuItemCount, currentMenuIndex);
             break;
-        case SHOW_SAVED_NETWORKS:
-            OledDisplay.showSavedNetworks();
-            break;
     }
 }
 
@@ -111,8 +128,39 @@ void showCurrentScreen(bool withTransition) {
 // Main Loop
 // ==========================
 void loop() {
+    wifiMenu.pollScan();  // Keep a background scan moving between screens
+    frameMonitor.poll();  // Channel hops and flood checks while monitoring
+    telemetry.update();   // Periodic TEL/TELOP serial lines
+
     Button btn = buttons.readButton();  // Read button press
 
+    // A key that only woke the blank display does nothing else
+    if (btn != NONE && power.onKey()) {
+        btn = NONE;
+    }
+    power.update(!wifiMenu.isScanning() && !wifiMenu.isAutoRescan() && !frameMonitor.isRunning() &&
+                 !feedback.isPlaying());
+
+    // Holding BACK closes everything and goes home from any depth
+    if (btn == BACK_LONG) {
+        screens.clear();
+        currentScreen = MAIN_MENU;
+        currentMenuIndex = 0;
+        showCurrentScreen(true);
+        return;
+    }
+
+    // An open screen gets the buttons and the display; the menu is
+    // redrawn once the last one closes
+    if (screens.isActive()) {
+        screens.run(btn);
+        if (!screens.isActive()) {
+            showCurrentScreen(true);
+        }
+        FramePacer::idle();
+        return;
+    }
+
     switch (btn) {
         case UP:
             currentMenuIndex--;
@@ -145,7 +193,8 @@ void loop() {
 
         case NONE:
         default:
-            // Do nothing if no button is pressed
+            // Nothing to redraw - sleep instead of spinning
+            FramePacer::idle();
             break;
     }
 }
@@ -167,7 +216,7 @@ void handleSelection(int selectedIndex) {
                     currentScreen = SETTINGS_MENU;
                     break;
                 case 3: // "Show Saved Networks"
-                    currentScreen = SHOW_SAVED_NETWORKS;
+                    OledDisplay.showSavedNetworks();
                     break;
                 default:
                     break;
@@ -186,16 +235,7 @@ case DEAUTH_MENU:
     if (selectedIndex == getCurrentMenuCount() - 1) {
         currentScreen = MAIN_MENU;
     } else {
-        // handleDeauthSelection(selectedIndex); // if implemented
-    }
-    break;
-
-case SHOW_SAVED_NETWORKS:
-    if(selectedIndex == getCurrentMenuCount() - 1){
-        currentScreen = MAIN_MENU;
-    }
-    else{
-        
+        handleDeauthSelection(selectedIndex);
     }
     break;
 
@@ -203,12 +243,14 @@ case SETTINGS_MENU:
     if (selectedIndex == getCurrentMenuCount() - 1) {
         currentScreen = MAIN_MENU;
     } else {
-        // handleSettingsSelection(selectedIndex); // if implemented
+        handleSettingsSelection(selectedIndex);
     }
     break;
 
     }
-    showCurrentScreen(true);  // Show the updated screen with transition
+    if (!screens.isActive()) {
+        showCurrentScreen(true);  // Show the updated screen with transition
+    }
 }
 
 // ==========================
@@ -220,7 +262,6 @@ int getCurrentMenuCount() {
         case WIFI_MENU: return wifiSubMenuItemCount;
         case DEAUTH_MENU: return deauthSubMenuItemCount;
         case SETTINGS_MENU: return settingSubMenuItemCount;
-        case SHOW_SAVED_NETWORKS: return 1;
         default: return 0;
     }
 }
@@ -231,6 +272,7 @@ int getCurrentMenuCount() {
 void handleWiFiSelection(int selectedIndex) {
     switch (selectedIndex) {
         case 0:  // WiFi Scan
+            frameMonitor.stop();      // One radio - scanning ends the monitor
             wifiMenu.scanNetworks();  // Perform network scan
             break;
         case 1:  // Show Networks
@@ -239,6 +281,64 @@ void handleWiFiSelection(int selectedIndex) {
         case 2:  // Filter Networks
             wifiMenu.filterNetworks();  // Filter networks based on criteria
             break;
+        case 3:  // Auto Rescan
+            frameMonitor.stop();
+            wifiMenu.setAutoRescan(!wifiMenu.isAutoRescan());
+            messageScreen.open(wifiMenu.isAutoRescan() ? F("Auto rescan ON") : F("Auto rescan OFF"), 800, -1, -1);
+            break;
+        case 4:  // Scan Mode
+            messageScreen.open(wifiMenu.nextScanMode(), 800, -1, -1);
+            break;
+        case 5:  // Sort Order
+            messageScreen.open(wifiMenu.nextSortKey(), 800, -1, -1);
+            break;
+        case 6:  // Channel Analyzer
+            if (wifiMenu.isScanning()) {
+                messageScreen.open(F("Wait for the scan\nto finish"), 1200, -1, -1);
+                feedback.play(FEEDBACK_ERROR);
+                break;
+            }
+            wifiMenu.setAutoRescan(false);
+            channelAnalyzer.showAnalyzer();
+            break;
+        default:
+            break;
+    }
+}
+
+// ==========================
+// Handle Deauth Submenu Selection
+// ==========================
+void handleDeauthSelection(int selectedIndex) {
+    switch (selectedIndex) {
+        case 5:  // Flood Monitor
+            if (wifiMenu.isScanning()) {
+                messageScreen.open(F("Wait for the scan\nto finish"), 1200, -1, -1);
+                feedback.play(FEEDBACK_ERROR);
+                break;
+            }
+            wifiMenu.setAutoRescan(false);
+            deauthDetector.showMonitor();
+            break;
+        default:
+            break;
+    }
+}
+
+// ==========================
+// Handle Settings Submenu Selection
+// ==========================
+void handleSettingsSelection(int selectedIndex) {
+    switch (selectedIndex) {
+        case 0:  // Buzzer Toggle
+            messageScreen.open(feedback.toggleBuzzer() ? F("Buzzer ON") : F("Buzzer OFF"), 800, -1, -1);
+            break;
+        case 2:  // TimeOut Settings
+            messageScreen.open(power.nextDisplayTimeout(), 800, -1, -1);
+            break;
+        case 4:  // Diagnostics
+            OledDisplay.showDiagnostics();
+            break;
         default:
             break;
     }
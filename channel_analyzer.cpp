@@ -0,0 +1,228 @@
+#include "channel_analyzer.h"
+#include "main_menu.h"
+
+// What the bars show, UP/DOWN cycles through them
+enum AnalyzerMetric : uint8_t {
+    ANALYZER_RATE,
+    ANALYZER_MGMT,
+    ANALYZER_RSSI,
+    ANALYZER_METRIC_COUNT
+};
+
+static const unsigned long ANALYZER_REFRESH_MS = 500;
+static const uint16_t ANALYZER_MIN_RATE_SCALE = 10;   // frames/s at full height
+static const int8_t ANALYZER_RSSI_FLOOR = -100;       // Empty bar
+static const int8_t ANALYZER_RSSI_CEIL = -30;         // Full bar
+
+// Bar graph layout
+static const int BAR_TOP = 24;
+static const int BAR_HEIGHT = 30;
+static const int BAR_PITCH = 9;
+static const int BAR_WIDTH = 7;
+static const int BAR_LEFT = (SCREEN_WIDTH - BAR_PITCH * (WIFI_MAX_CHANNEL - WIFI_MIN_CHANNEL + 1)) / 2 + 1;
+
+ChannelAnalyzer channelAnalyzer;
+
+ChannelAnalyzer::ChannelAnalyzer() :
+    analyzerScreen(*this)
+{
+    reset();
+}
+
+void ChannelAnalyzer::reset() {
+    memset(windows, 0, sizeof(windows));
+    memset(totals, 0, sizeof(totals));
+    current = 0;
+    windowStart = millis();
+    lastUpdate = windowStart;
+}
+
+// ===== Counting =====
+
+void ChannelAnalyzer::countFrame(const FrameSummary& frame) {
+    uint8_t channel = frame.channel < MONITOR_CHANNEL_SLOTS ? frame.channel : 0;
+    Window& window = windows[current][channel];
+    Totals& total = totals[channel];
+
+    window.frames++;
+    total.frames++;
+    window.rssiSum += frame.rssi;
+    total.rssiSum += frame.rssi;
+    if (frame.type() == FRAME_TYPE_MGMT) {
+        window.mgmt++;
+        total.mgmt++;
+    } else if (frame.type() == FRAME_TYPE_DATA) {
+        window.data++;
+        total.data++;
+    }
+}
+
+// Credits the time since the last pass to the channel being listened on
+void ChannelAnalyzer::update(uint8_t listening, unsigned long now) {
+    if (listening < MONITOR_CHANNEL_SLOTS) {
+        uint16_t elapsed = (uint16_t)min(now - lastUpdate, (unsigned long)ANALYZER_WINDOW_MS);
+        windows[current][listening].listenMs += elapsed;
+        totals[listening].listenMs += elapsed;
+    }
+    lastUpdate = now;
+
+    if (now - windowStart >= ANALYZER_WINDOW_MS) {
+        windowStart = now;
+        rotate();
+        analyzerScreen.invalidate();
+    }
+}
+
+// The oldest window leaves the totals and becomes the current one
+void ChannelAnalyzer::rotate() {
+    current = (current + 1) % ANALYZER_WINDOWS;
+    for (uint8_t ch = 0; ch < MONITOR_CHANNEL_SLOTS; ch++) {
+        const Window& old = windows[current][ch];
+        Totals& total = totals[ch];
+        total.frames -= old.frames;
+        total.mgmt -= old.mgmt;
+        total.data -= old.data;
+        total.listenMs -= old.listenMs;
+        total.rssiSum -= old.rssiSum;
+    }
+    memset(windows[current], 0, sizeof(windows[current]));
+}
+
+// ===== Readings =====
+
+uint16_t ChannelAnalyzer::getFrameRate(uint8_t channel) const {
+    const Totals& total = totals[channel];
+    if (total.listenMs == 0) {
+        return 0;
+    }
+    return (uint16_t)min((uint32_t)((uint64_t)total.frames * 1000 / total.listenMs), (uint32_t)0xFFFF);
+}
+
+uint8_t ChannelAnalyzer::getMgmtPercent(uint8_t channel) const {
+    const Totals& total = totals[channel];
+    uint32_t typed = total.mgmt + total.data;
+    if (typed == 0) {
+        return 0;
+    }
+    return (uint8_t)(total.mgmt * 100 / typed);
+}
+
+int8_t ChannelAnalyzer::getMeanRssi(uint8_t channel) const {
+    const Totals& total = totals[channel];
+    if (total.frames == 0) {
+        return 0;
+    }
+    return (int8_t)(total.rssiSum / (int32_t)total.frames);
+}
+
+// ===== Analyzer screen =====
+
+void ChannelAnalyzer::showAnalyzer() {
+    screens.push(&analyzerScreen);
+}
+
+void ChannelAnalyzer::AnalyzerScreen::onEnter() {
+    lastRefresh = millis();
+}
+
+void ChannelAnalyzer::AnalyzerScreen::update(Button btn) {
+    unsigned long now = millis();
+    if (frameMonitor.isRunning() && now - lastRefresh >= ANALYZER_REFRESH_MS) {
+        lastRefresh = now;
+        invalidate();
+    }
+
+    if (btn != NONE) invalidate();
+    switch (btn) {
+        case SELECT:
+            if (frameMonitor.isRunning()) {
+                frameMonitor.stop();
+            } else {
+                frameMonitor.start();
+            }
+            break;
+        case UP:
+            metric = (metric + ANALYZER_METRIC_COUNT - 1) % ANALYZER_METRIC_COUNT;
+            break;
+        case DOWN:
+            metric = (metric + 1) % ANALYZER_METRIC_COUNT;
+            break;
+        case BACK:
+            screens.pop();  // The monitor keeps running
+            break;
+        default:
+            break;
+    }
+}
+
+void ChannelAnalyzer::AnalyzerScreen::render() {
+    // Title bar
+    display.fillRect(0, 0, SCREEN_WIDTH, 12, SSD1306_WHITE);
+    display.setTextColor(SSD1306_BLACK);
+    display.setCursor((SCREEN_WIDTH - 96) / 2, 2);
+    display.print(F("CHANNEL ANALYZER"));
+    display.setTextColor(SSD1306_WHITE);
+
+    // Bar heights, and the channel with the highest reading
+    uint16_t values[MONITOR_CHANNEL_SLOTS] = { 0 };
+    uint16_t scale = 100;
+    uint8_t peak = 0;
+    for (uint8_t ch = WIFI_MIN_CHANNEL; ch <= WIFI_MAX_CHANNEL; ch++) {
+        if (!analyzer.hasData(ch)) continue;
+        switch (metric) {
+            case ANALYZER_RATE:
+                values[ch] = analyzer.getFrameRate(ch);
+                break;
+            case ANALYZER_MGMT:
+                values[ch] = analyzer.getMgmtPercent(ch);
+                break;
+            default:
+                if (analyzer.getMeanRssi(ch) != 0) {
+                    values[ch] = constrain(analyzer.getMeanRssi(ch), ANALYZER_RSSI_FLOOR, ANALYZER_RSSI_CEIL) - ANALYZER_RSSI_FLOOR;
+                }
+                break;
+        }
+        if (peak == 0 || values[ch] > values[peak]) {
+            peak = ch;
+        }
+    }
+    if (metric == ANALYZER_RATE) {
+        scale = max(ANALYZER_MIN_RATE_SCALE, peak ? values[peak] : (uint16_t)0);
+    } else if (metric == ANALYZER_RSSI) {
+        scale = ANALYZER_RSSI_CEIL - ANALYZER_RSSI_FLOOR;
+    }
+
+    char line[40];
+    const char* name = metric == ANALYZER_RATE ? "Frames/s" : metric == ANALYZER_MGMT ? "Mgmt %" : "RSSI";
+    if (!frameMonitor.isRunning()) {
+        snprintf(line, sizeof(line), "%-8s   SEL:Start", name);
+    } else if (peak == 0) {
+        snprintf(line, sizeof(line), "%-8s   listening", name);
+    } else if (metric == ANALYZER_RSSI) {
+        snprintf(line, sizeof(line), "%-8s top %2u:%4d", name, peak, analyzer.getMeanRssi(peak));
+    } else {
+        snprintf(line, sizeof(line), "%-8s top %2u:%4u", name, peak, values[peak]);
+    }
+    display.setCursor(0, 14);
+    display.print(line);
+
+    for (uint8_t ch = WIFI_MIN_CHANNEL; ch <= WIFI_MAX_CHANNEL; ch++) {
+        int x = BAR_LEFT + (ch - WIFI_MIN_CHANNEL) * BAR_PITCH;
+        int h = (uint32_t)values[ch] * BAR_HEIGHT / scale;
+        if (h > BAR_HEIGHT) h = BAR_HEIGHT;
+        if (h > 0) {
+            display.fillRect(x, BAR_TOP + BAR_HEIGHT - h, BAR_WIDTH, h, SSD1306_WHITE);
+        }
+        if (frameMonitor.isRunning() && ch == frameMonitor.getChannel()) {
+            display.drawFastHLine(x, BAR_TOP + BAR_HEIGHT + 1, BAR_WIDTH, SSD1306_WHITE);   // Listening now
+        }
+    }
+
+    // Channel numbers under bars 1, 6 and 11
+    static const uint8_t LABELS[] = { 1, 6, 11 };
+    for (uint8_t i = 0; i < sizeof(LABELS); i++) {
+        int x = BAR_LEFT + (LABELS[i] - WIFI_MIN_CHANNEL) * BAR_PITCH;
+        display.setCursor(LABELS[i] < 10 ? x + 1 : x - 2, SCREEN_HEIGHT - 8);
+        display.print(LABELS[i]);
+    }
+}
@@ -0,0 +1,77 @@
+#ifndef CHANNEL_ANALYZER_H
+#define CHANNEL_ANALYZER_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "monitor.h"
+#include "screen.h"
+
+// How busy each channel is, from what the FrameMonitor hears. Frames are
+// counted per channel into the current window of a small ring of
+// ANALYZER_WINDOWS fixed-length windows, and into running totals over the
+// whole ring; when a window ends the oldest one is subtracted from the
+// totals and reused. Adding a frame is a few increments and every reading
+// comes from the totals, so the cost never depends on the traffic.
+// Rates are per second of listening on the channel, not of wall time, so
+// the hop schedule does not skew them.
+class ChannelAnalyzer {
+public:
+    ChannelAnalyzer();
+
+    void reset();                                  // FrameMonitor::start()
+    void countFrame(const FrameSummary& frame);    // FrameMonitor::poll(), per frame
+    void update(uint8_t listening, unsigned long now);   // FrameMonitor::poll(), per pass
+
+    bool hasData(uint8_t channel) const { return totals[channel].listenMs > 0; }
+    uint16_t getFrameRate(uint8_t channel) const;  // frames/s
+    uint8_t getMgmtPercent(uint8_t channel) const; // Of management + data frames
+    int8_t getMeanRssi(uint8_t channel) const;     // 0 if nothing heard
+
+    void showAnalyzer();                           // WiFi Scan > Channel Analyzer
+
+private:
+    struct Window {
+        uint16_t frames;
+        uint16_t mgmt;
+        uint16_t data;
+        uint16_t listenMs;
+        int32_t rssiSum;
+    };
+
+    struct Totals {
+        uint32_t frames;
+        uint32_t mgmt;
+        uint32_t data;
+        uint32_t listenMs;
+        int32_t rssiSum;
+    };
+
+    void rotate();
+
+    Window windows[ANALYZER_WINDOWS][MONITOR_CHANNEL_SLOTS];
+    Totals totals[MONITOR_CHANNEL_SLOTS];   // Sum of all windows, the current one included
+    uint8_t current;
+    unsigned long windowStart;
+    unsigned long lastUpdate;
+
+    // One bar per channel; SELECT starts and stops the monitor, UP/DOWN
+    // pick what the bars show
+    class AnalyzerScreen : public Screen {
+    public:
+        explicit AnalyzerScreen(ChannelAnalyzer& analyzer) : analyzer(analyzer), metric(0) {}
+        void update(Button btn) override;
+        void render() override;
+        void onEnter() override;
+
+    private:
+        ChannelAnalyzer& analyzer;
+        uint8_t metric;
+        unsigned long lastRefresh;
+    };
+
+    AnalyzerScreen analyzerScreen;
+};
+
+extern ChannelAnalyzer channelAnalyzer;
+
+#endif
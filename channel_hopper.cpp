@@ -0,0 +1,107 @@
+#include "channel_hopper.h"
+#include "deauth_detector.h"
+#include "saved_networks.h"
+
+// Weights, in shares of a round
+static const uint16_t HOP_BASE_WEIGHT = 4;        // Every channel
+static const uint16_t HOP_RATE_PER_WEIGHT = 25;   // frames/s for one extra share
+static const uint16_t HOP_MAX_BUSY_WEIGHT = 8;
+static const uint16_t HOP_WATCH_WEIGHT = 6;       // A saved network is on the channel
+static const uint16_t HOP_SUSPECT_WEIGHT = 12;    // Deauths heard lately
+static const uint8_t HOP_SUSPECT_VISITS = 3;
+
+static const uint8_t HOP_CHANNELS = WIFI_MAX_CHANNEL - WIFI_MIN_CHANNEL + 1;
+static const unsigned long HOP_ROUND_MS = (unsigned long)MONITOR_DWELL_MS * HOP_CHANNELS;
+
+ChannelHopper channelHopper;
+
+ChannelHopper::ChannelHopper() {
+    reset();
+}
+
+void ChannelHopper::reset() {
+    memset(activity, 0, sizeof(activity));
+    memset(suspect, 0, sizeof(suspect));
+    memset(listenMs, 0, sizeof(listenMs));
+    totalMs = 0;
+    roundChannel = WIFI_MAX_CHANNEL;   // The first round starts at channel 1
+    pinVisited = false;
+}
+
+void ChannelHopper::endDwell(uint8_t channel, unsigned long dwellMs, uint16_t frames, uint16_t deauths) {
+    if (channel >= MONITOR_CHANNEL_SLOTS || dwellMs == 0) {
+        return;
+    }
+    listenMs[channel] += dwellMs;
+    totalMs += dwellMs;
+
+    uint32_t rate = (uint32_t)frames * 1000 / dwellMs;
+    activity[channel] = (uint16_t)(((uint32_t)activity[channel] * 3 + min(rate, (uint32_t)0xFFFF)) / 4);
+
+    if (deauths > 0) {
+        suspect[channel] = HOP_SUSPECT_VISITS;
+    } else if (suspect[channel] > 0) {
+        suspect[channel]--;
+    }
+}
+
+uint16_t ChannelHopper::weight(uint8_t channel) const {
+    uint16_t w = HOP_BASE_WEIGHT;
+    w += min((uint16_t)(activity[channel] / HOP_RATE_PER_WEIGHT), HOP_MAX_BUSY_WEIGHT);
+    if (suspect[channel] > 0) {
+        w += HOP_SUSPECT_WEIGHT;
+    }
+    for (int i = 0; i < savedNetworks.count(); i++) {
+        if (savedNetworks.get(i).channel == channel) {
+            w += HOP_WATCH_WEIGHT;
+            break;
+        }
+    }
+    return w;
+}
+
+uint8_t ChannelHopper::next(unsigned long& dwellMs) {
+    uint8_t pinned = deauthDetector.isAlerting() ? deauthDetector.getAlertChannel() : 0;
+    if (pinned >= WIFI_MIN_CHANNEL && pinned <= WIFI_MAX_CHANNEL && !pinVisited) {
+        pinVisited = true;
+        dwellMs = MONITOR_PIN_DWELL_MS;
+        return pinned;
+    }
+    pinVisited = false;
+
+    roundChannel = roundChannel >= WIFI_MAX_CHANNEL ? WIFI_MIN_CHANNEL : roundChannel + 1;
+    if (pinned && roundChannel == pinned) {
+        roundChannel = roundChannel >= WIFI_MAX_CHANNEL ? WIFI_MIN_CHANNEL : roundChannel + 1;
+    }
+    if (pinned) {
+        dwellMs = MONITOR_MIN_DWELL_MS;   // Excursion from the alert channel
+        return roundChannel;
+    }
+
+    uint32_t total = 0;
+    for (uint8_t ch = WIFI_MIN_CHANNEL; ch <= WIFI_MAX_CHANNEL; ch++) {
+        total += weight(ch);
+    }
+    unsigned long spare = HOP_ROUND_MS - (unsigned long)MONITOR_MIN_DWELL_MS * HOP_CHANNELS;
+    dwellMs = MONITOR_MIN_DWELL_MS + spare * weight(roundChannel) / total;
+    return roundChannel;
+}
+
+uint16_t ChannelHopper::getTimeShare(uint8_t channel) const {
+    if (totalMs == 0 || channel >= MONITOR_CHANNEL_SLOTS) {
+        return 0;
+    }
+    return (uint16_t)((uint64_t)listenMs[channel] * 1000 / totalMs);
+}
+
+void ChannelHopper::printReport() const {
+    Serial.print(F("Monitor: time per channel"));
+    for (uint8_t ch = WIFI_MIN_CHANNEL; ch <= WIFI_MAX_CHANNEL; ch++) {
+        Serial.print(' ');
+        Serial.print(ch);
+        Serial.print(':');
+        Serial.print((getTimeShare(ch) + 5) / 10);
+        Serial.print('%');
+    }
+    Serial.println();
+}
@@ -0,0 +1,43 @@
+#ifndef CHANNEL_HOPPER_H
+#define CHANNEL_HOPPER_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "monitor.h"
+
+// Decides where the monitor listens next and for how long. Every round
+// still visits channels 1-13 in order, but the round's time is shared out
+// by weight: a base share for every channel, more for busy ones, for
+// channels a saved network is on and for channels where deauths were
+// heard lately. While a flood alert is up the alert channel is pinned -
+// long dwells there, each followed by one short visit to the next channel
+// of the round so the others are not lost from view.
+class ChannelHopper {
+public:
+    ChannelHopper();
+
+    void reset();                  // FrameMonitor::start()
+
+    // What the dwell that just ended heard
+    void endDwell(uint8_t channel, unsigned long dwellMs, uint16_t frames, uint16_t deauths);
+
+    // Channel to tune to next; dwellMs is set to how long to stay
+    uint8_t next(unsigned long& dwellMs);
+
+    uint16_t getTimeShare(uint8_t channel) const;   // Per mille of the time since reset()
+    void printReport() const;
+
+private:
+    uint16_t weight(uint8_t channel) const;
+
+    uint16_t activity[MONITOR_CHANNEL_SLOTS];      // frames/s, smoothed over visits
+    uint8_t suspect[MONITOR_CHANNEL_SLOTS];        // Visits left with the deauth bonus
+    uint32_t listenMs[MONITOR_CHANNEL_SLOTS];
+    uint32_t totalMs;
+    uint8_t roundChannel;          // Last channel of the round visited
+    bool pinVisited;               // Alert channel had its dwell, an excursion is next
+};
+
+extern ChannelHopper channelHopper;
+
+#endif
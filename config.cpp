@@ -13,6 +13,10 @@ const char* wifiSubMenuItems[] = {
     "Scan",
     "Show Networks",
     "Filter",
+    "Auto Rescan",
+    "Scan Mode",
+    "Sort Order",
+    "Channel Analyzer",
     "Go Back"
 };
 
@@ -24,6 +28,7 @@ const char* deauthSubMenuItems[] = {
     "Attack Type",
     "Packet Count",
     "Start Attack",
+    "Flood Monitor",
     "Go Back"
 };
 
@@ -34,6 +39,7 @@ const char* settingSubMenuItems[] = {
     "Display Brightness",
     "TimeOut Settings",
     "Firmware Info",
+    "Diagnostics",
     "Go Back"
 };
 
@@ -5,13 +5,38 @@
 #define WIFI_SSID       "Your Wifi Name"
 #define WIFI_PASSWORD   "Wifi Password"
 #define WIFI_SCAN_TIMEOUT 10     // In seconds
-#define MAX_SCAN_RESULTS 20
+#define WIFI_MIN_CHANNEL   1
+#define WIFI_MAX_CHANNEL   13
+#define SCAN_CHANNEL_TIMEOUT_MS 500   // Grace past the dwell before giving up on a channel
+#define SCAN_STALE_GRACE_MS     1000  // Wait this long for a given-up scan to report before the next
+#define SCAN_ACTIVE_DWELL_MS    60    // Default per-channel dwell (active probing)
+#define SCAN_MIN_DWELL_MS       20
+#define SCAN_MAX_DWELL_MS       1000
+#define SCAN_QUIET_CHANNEL_INTERVAL 4 // Adaptive sweeps revisit empty channels this often
+#define SCAN_RESULT_BUFFER      48    // APs buffered from one channel's SDK callback
+#define NETWORK_STALE_MS   60000   // Unseen this long: first to be evicted when full
+#define NETWORK_EXPIRE_MS  300000  // Unseen this long: dropped after a sweep
+#define AUTO_RESCAN_INTERVAL_MS 1000  // Pause between sweeps in auto rescan mode
+#define SCAN_MIN_CAPACITY  20      // Networks tracked even when the heap is tight
+#define SCAN_MAX_CAPACITY  512
+#define SCAN_HEAP_RESERVE  16384   // Heap left free at boot for the WiFi stack, Strings, etc.
+#define SSID_POOL_BYTES_PER_AP 16  // Interned SSID text budgeted per tracked network
+
+// ===================== Diagnostics =====================
+#define TELEMETRY_SERIAL_INTERVAL_MS 10000  // TEL/TELOP serial lines, 0 to disable
 
 // ===================== Button Pins =====================
 #define BUTTON_UP_PIN      D6
 #define BUTTON_DOWN_PIN    D3
 #define BUTTON_SELECT_PIN  D4
 #define BUTTON_BACK_PIN    D5
+#define BUTTON_DEBOUNCE_MS         25    // Edges closer than this to the last one are bounce
+#define BUTTON_LONG_PRESS_MS       800
+#define BUTTON_REPEAT_DELAY_MS     400   // UP/DOWN held this long start repeating
+#define BUTTON_REPEAT_MS           100
+#define BUTTON_REPEAT_FAST_MS      40    // Once held past BUTTON_REPEAT_FAST_AFTER_MS
+#define BUTTON_REPEAT_FAST_AFTER_MS 1500
+#define BUTTON_QUEUE_SIZE          16    // Power of two
 
 // ===================== LED & Buzzer =====================
 #define LED_PIN            D8
@@ -24,6 +49,34 @@
 #define SCREEN_HEIGHT      64
 #define OLED_RESET         -1
 #define OLED_ADDRESS       0x3C
+#define UI_MAX_FPS         30      // Cap on frames pushed to the panel, all screens together
+#define UI_IDLE_SLICE_MS   5       // Sleep per UI loop pass when there is nothing to do
+#define SCREEN_STACK_DEPTH 6       // Screens open on top of the menus at once
+
+// ===================== Power =====================
+#define POWER_DISPLAY_TIMEOUT_MS 30000  // No key this long: dim (Settings > TimeOut Settings)
+#define POWER_BLANK_AFTER_DIM_MS 15000  // Then switch the panel off
+#define POWER_SLEEP_ENTRY_MS     10     // Light sleep starts inside this delay()
+
+// ===================== Monitor =====================
+#define MONITOR_DWELL_MS       200    // Mean per-channel dwell; one hop round over 1-13 takes 13x this
+#define MONITOR_MIN_DWELL_MS   60     // Shortest dwell, for quiet channels
+#define MONITOR_PIN_DWELL_MS   800    // On the alert channel between excursions
+#define FRAME_RING_SLOTS       64     // Frame summaries between the RX callback and loop(); power of two
+#define FRAME_RING_COPY_BYTES  0      // >0 also keeps the first N header bytes of each frame
+#define ANALYZER_WINDOW_MS     2000   // Channel analyzer: counters roll over in windows this long
+#define ANALYZER_WINDOWS       4      // ... and readings cover this many of them
+#define DEAUTH_ALERT_RATE      10     // Deauth + disassoc frames/s, from one BSSID or on one channel
+#define DEAUTH_ALERT_MIN_FRAMES 5    // Fewer in the rate window never alert, however short the dwells
+#define DEAUTH_RATE_WINDOW_MS  2000   // Listening time the rates are taken over, per channel and BSSID
+#define DEAUTH_ALERT_CLEAR_MS  10000  // Below the rate this long ends an alert
+#define DEAUTH_ALERT_SHOW_MS   4000   // Alert message over other screens
+#define DEAUTH_TRACKED_BSSIDS  16
+#define DEAUTH_FORGET_MS       60000  // BSSIDs not heard this long free their slot
+
+// ===================== Storage =====================
+#define JOURNAL_COMPACT_BYTES 4096  // Journal file size that triggers a compaction
+#define JOURNAL_MAX_CLIENTS   6
 
 // ===================== Menu Configuration =====================
 #define MAX_MENU_ITEMS        10
@@ -0,0 +1,346 @@
+#include "deauth_detector.h"
+#include "main_menu.h"
+#include "network_record.h"
+#include "feedback.h"
+#include "power.h"
+#include "channel_hopper.h"
+
+// Deauth > Flood Monitor, UP/DOWN
+static const uint16_t DEAUTH_THRESHOLDS[] = { 5, 10, 20, 50, 100 };
+static const uint8_t DEAUTH_THRESHOLD_COUNT = sizeof(DEAUTH_THRESHOLDS) / sizeof(DEAUTH_THRESHOLDS[0]);
+
+static const unsigned long MONITOR_REFRESH_MS = 500;
+
+DeauthDetector deauthDetector;
+
+DeauthDetector::DeauthDetector() :
+    untracked(0),
+    thresholdIndex(0),
+    alerting(false),
+    alertChannel(0),
+    alertRate(0),
+    lastOverThreshold(0),
+    monitorScreen(*this)
+{
+    memset(bssids, 0, sizeof(bssids));
+    memset(channelDwellCount, 0, sizeof(channelDwellCount));
+    memset(channelTotal, 0, sizeof(channelTotal));
+    memset(channelWindow, 0, sizeof(channelWindow));
+    memset(alertBssid, 0, sizeof(alertBssid));
+    for (uint8_t i = 0; i < DEAUTH_THRESHOLD_COUNT; i++) {
+        if (DEAUTH_THRESHOLDS[i] == DEAUTH_ALERT_RATE) {
+            thresholdIndex = i;
+        }
+    }
+}
+
+// ===== Counting =====
+
+void DeauthDetector::countFrame(const uint8_t* bssid, uint8_t channel) {
+    if (channel >= MONITOR_CHANNEL_SLOTS) {
+        channel = 0;
+    }
+    channelDwellCount[channel]++;
+
+    int freeSlot = -1;
+    for (int i = 0; i < DEAUTH_TRACKED_BSSIDS; i++) {
+        BssidCount& entry = bssids[i];
+        if (!entry.used) {
+            if (freeSlot < 0) freeSlot = i;
+            continue;
+        }
+        if (memcmp(entry.bssid, bssid, sizeof(entry.bssid)) == 0) {
+            entry.dwellCount++;
+            return;
+        }
+    }
+    if (freeSlot < 0) {
+        untracked++;
+        return;
+    }
+
+    BssidCount& entry = bssids[freeSlot];
+    memcpy(entry.bssid, bssid, sizeof(entry.bssid));
+    entry.channel = channel;
+    entry.dwellCount = 1;
+    entry.window.count = 0;
+    entry.window.ms = 0;
+    entry.peakRate = 0;
+    entry.total = 0;
+    entry.lastSeen = 0;
+    entry.used = true;
+}
+
+// Adds one dwell to a window that spans several, halving it once it holds
+// more than DEAUTH_RATE_WINDOW_MS of listening so old dwells fade out.
+// Returns the higher of the dwell's own rate, which catches short bursts,
+// and the window's, which catches slow steady floods - each only once it
+// rests on DEAUTH_ALERT_MIN_FRAMES frames, so a client leaving is never
+// a flood: one frame in a 60 ms dwell is not 16/s.
+uint16_t DeauthDetector::slide(RateWindow& window, uint16_t count, unsigned long dwellMs) {
+    uint16_t dwellRate = 0;
+    if (count >= DEAUTH_ALERT_MIN_FRAMES) {
+        dwellRate = (uint32_t)count * 1000 / dwellMs;
+    }
+
+    while (window.ms + dwellMs > DEAUTH_RATE_WINDOW_MS && window.ms > 0) {
+        window.ms /= 2;
+        window.count /= 2;
+    }
+    window.ms += min(dwellMs, (unsigned long)DEAUTH_RATE_WINDOW_MS);
+    window.count = (uint16_t)min((uint32_t)window.count + count, (uint32_t)0xFFFF);
+    if (window.count < DEAUTH_ALERT_MIN_FRAMES || window.ms == 0) {
+        return dwellRate;
+    }
+    return max(dwellRate, (uint16_t)((uint32_t)window.count * 1000 / window.ms));
+}
+
+// Everything counted since the last call was heard on this channel
+void DeauthDetector::endDwell(uint8_t channel, unsigned long dwellMs) {
+    unsigned long now = millis();
+    uint16_t threshold = getThreshold();
+    bool over = false;
+    if (dwellMs == 0) {
+        dwellMs = 1;
+    }
+
+    for (int i = 0; i < DEAUTH_TRACKED_BSSIDS; i++) {
+        BssidCount& entry = bssids[i];
+        if (!entry.used) {
+            continue;
+        }
+        if (entry.dwellCount == 0) {
+            if (entry.lastSeen != 0 && now - entry.lastSeen >= DEAUTH_FORGET_MS) {
+                entry.used = false;
+            } else if (entry.channel == channel) {
+                slide(entry.window, 0, dwellMs);   // Listened, heard nothing
+            }
+            continue;
+        }
+
+        if (entry.channel != channel) {
+            entry.window.count = 0;   // Moved - its old window says nothing here
+            entry.window.ms = 0;
+        }
+        uint16_t rate = slide(entry.window, entry.dwellCount, dwellMs);
+        entry.total += entry.dwellCount;
+        entry.dwellCount = 0;
+        entry.channel = channel;
+        entry.lastSeen = now;
+        if (rate > entry.peakRate) {
+            entry.peakRate = rate;
+        }
+        if (rate >= threshold) {
+            raiseAlert(entry.bssid, channel, rate);
+            over = true;
+        }
+    }
+
+    uint16_t count = channelDwellCount[channel];
+    channelDwellCount[channel] = 0;
+    channelTotal[channel] += count;
+    uint16_t channelRate = slide(channelWindow[channel], count, dwellMs);
+    if (!over && channelRate >= threshold) {
+        // Spread over many spoofed BSSIDs, none of them over on its own
+        raiseAlert(nullptr, channel, channelRate);
+        over = true;
+    }
+
+    if (over) {
+        lastOverThreshold = now;
+    } else if (alerting && now - lastOverThreshold >= DEAUTH_ALERT_CLEAR_MS) {
+        Serial.println(F("Deauth flood: cleared"));
+        clearAlert();
+    }
+}
+
+uint32_t DeauthDetector::getTotal() const {
+    uint32_t total = 0;
+    for (uint8_t i = 0; i < MONITOR_CHANNEL_SLOTS; i++) {
+        total += channelTotal[i];
+    }
+    return total;
+}
+
+// ===== Alerts =====
+
+void DeauthDetector::raiseAlert(const uint8_t* bssid, uint8_t channel, uint16_t rate) {
+    bool wasAlerting = alerting;
+    alerting = true;
+    alertChannel = channel;
+    alertRate = rate;
+    if (bssid) {
+        memcpy(alertBssid, bssid, sizeof(alertBssid));
+    } else {
+        memset(alertBssid, 0, sizeof(alertBssid));
+    }
+    monitorScreen.invalidate();
+    if (wasAlerting) {
+        return;
+    }
+
+    char source[18];
+    if (bssid) {
+        formatBssid(bssid, source);
+    } else {
+        strcpy(source, "many BSSIDs");
+    }
+    Serial.print(F("ALERT: deauth flood on channel "));
+    Serial.print(channel);
+    Serial.print(F(", "));
+    Serial.print(rate);
+    Serial.print(F("/s from "));
+    Serial.println(source);
+
+    feedback.play(FEEDBACK_ALERT);
+    power.wakeDisplay();
+    if (screens.top() != &monitorScreen) {
+        char text[64];
+        snprintf(text, sizeof(text), "DEAUTH FLOOD\nCH %u  %u/s\n%s", channel, rate, source);
+        messageScreen.open(text, DEAUTH_ALERT_SHOW_MS, -1, -1);
+    }
+}
+
+// A new run starts from empty windows, not the tail of the last one
+void DeauthDetector::resetRates() {
+    memset(channelWindow, 0, sizeof(channelWindow));
+    for (int i = 0; i < DEAUTH_TRACKED_BSSIDS; i++) {
+        bssids[i].window.count = 0;
+        bssids[i].window.ms = 0;
+    }
+}
+
+void DeauthDetector::clearAlert() {
+    alerting = false;
+    monitorScreen.invalidate();
+}
+
+// ===== Threshold =====
+
+uint16_t DeauthDetector::getThreshold() const {
+    return DEAUTH_THRESHOLDS[thresholdIndex];
+}
+
+void DeauthDetector::stepThreshold(int direction) {
+    int index = thresholdIndex + direction;
+    if (index < 0 || index >= DEAUTH_THRESHOLD_COUNT) {
+        return;
+    }
+    thresholdIndex = index;
+    snapshot(journal);
+}
+
+void DeauthDetector::restore(uint8_t type, const uint8_t* data, uint8_t len) {
+    if (type != JOURNAL_DEAUTH_RATE || len != sizeof(uint16_t)) {
+        return;
+    }
+    uint16_t rate;
+    memcpy(&rate, data, sizeof(rate));
+    for (uint8_t i = 0; i < DEAUTH_THRESHOLD_COUNT; i++) {
+        if (DEAUTH_THRESHOLDS[i] == rate) {
+            thresholdIndex = i;
+        }
+    }
+}
+
+void DeauthDetector::snapshot(Journal& journal) {
+    uint16_t rate = getThreshold();
+    journal.append(JOURNAL_DEAUTH_RATE, &rate, sizeof(rate));
+}
+
+// ===== Monitor screen =====
+
+void DeauthDetector::showMonitor() {
+    screens.push(&monitorScreen);
+}
+
+void DeauthDetector::MonitorScreen::onEnter() {
+    lastRefresh = millis();
+}
+
+void DeauthDetector::MonitorScreen::update(Button btn) {
+    unsigned long now = millis();
+    if (frameMonitor.isRunning() && now - lastRefresh >= MONITOR_REFRESH_MS) {
+        lastRefresh = now;
+        invalidate();
+    }
+
+    if (btn != NONE) invalidate();
+    switch (btn) {
+        case SELECT:
+            if (frameMonitor.isRunning()) {
+                frameMonitor.stop();
+            } else {
+                frameMonitor.start();
+            }
+            break;
+        case UP:
+            detector.stepThreshold(1);
+            break;
+        case DOWN:
+            detector.stepThreshold(-1);
+            break;
+        case BACK:
+            screens.pop();  // The monitor keeps running
+            break;
+        default:
+            break;
+    }
+}
+
+void DeauthDetector::MonitorScreen::render() {
+    // Title bar
+    display.fillRect(0, 0, SCREEN_WIDTH, 12, SSD1306_WHITE);
+    display.setTextColor(SSD1306_BLACK);
+    display.setCursor((SCREEN_WIDTH - 78) / 2, 2);
+    display.print(F("FLOOD MONITOR"));
+    display.setTextColor(SSD1306_WHITE);
+
+    char line[40];
+    if (frameMonitor.isRunning()) {
+        uint8_t channel = frameMonitor.getChannel();
+        snprintf(line, sizeof(line), "CH %-2u %3u%% Alert %3u/s", channel,
+                 (channelHopper.getTimeShare(channel) + 5) / 10, detector.getThreshold());
+    } else {
+        snprintf(line, sizeof(line), "Stopped   Alert %3u/s", detector.getThreshold());
+    }
+    display.setCursor(0, 15);
+    display.print(line);
+
+    snprintf(line, sizeof(line), "Rx %-7lu Deauth %lu", (unsigned long)frameMonitor.getFrameCount(),
+             (unsigned long)detector.getTotal());
+    display.setCursor(0, 25);
+    display.print(line);
+
+    // The two loudest BSSIDs so far
+    int shown[2] = { -1, -1 };
+    for (int row = 0; row < 2; row++) {
+        for (int i = 0; i < DEAUTH_TRACKED_BSSIDS; i++) {
+            const BssidCount& entry = detector.bssids[i];
+            if (!entry.used || entry.total == 0 || i == shown[0]) continue;
+            if (shown[row] < 0 || entry.total > detector.bssids[shown[row]].total) {
+                shown[row] = i;
+            }
+        }
+        if (shown[row] < 0) break;
+
+        const BssidCount& entry = detector.bssids[shown[row]];
+        snprintf(line, sizeof(line), "%02X:%02X:%02X:%02X c%-2u %5lu",
+                 entry.bssid[2], entry.bssid[3], entry.bssid[4], entry.bssid[5],
+                 entry.channel, (unsigned long)entry.total);
+        display.setCursor(0, 35 + row * 9);
+        display.print(line);
+    }
+
+    // Footer, or the alert in its place
+    if (detector.alerting) {
+        display.fillRect(0, SCREEN_HEIGHT - 10, SCREEN_WIDTH, 10, SSD1306_WHITE);
+        display.setTextColor(SSD1306_BLACK);
+        snprintf(line, sizeof(line), "FLOOD CH %u  %u/s", detector.alertChannel, detector.alertRate);
+        display.setCursor(2, SCREEN_HEIGHT - 9);
+        display.print(line);
+    } else {
+        display.setCursor(0, SCREEN_HEIGHT - 8);
+        display.print(frameMonitor.isRunning() ? F("SEL:Stop UP/DN:Alert") : F("SEL:Start UP/DN:Alert"));
+    }
+}
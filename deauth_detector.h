@@ -0,0 +1,93 @@
+#ifndef DEAUTH_DETECTOR_H
+#define DEAUTH_DETECTOR_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "monitor.h"
+#include "screen.h"
+#include "journal.h"
+
+// Spots deauthentication/disassociation floods in what the FrameMonitor
+// hears. Frames are counted per BSSID and per channel as they arrive; at
+// the end of each dwell the counts join a window over the last few dwells
+// on that channel, and a window rate at or above the threshold - from one
+// BSSID or on one channel, and over at least DEAUTH_ALERT_MIN_FRAMES
+// frames - raises an alert on
+// the display, the buzzer and the LED. The alert holds until no rate has
+// reached the threshold for DEAUTH_ALERT_CLEAR_MS.
+class DeauthDetector : public JournalClient {
+public:
+    DeauthDetector();
+
+    void countFrame(const uint8_t* bssid, uint8_t channel);  // FrameMonitor::poll(), per frame
+    void endDwell(uint8_t channel, unsigned long dwellMs);   // FrameMonitor::poll()
+    void clearAlert();
+    void resetRates();                                       // FrameMonitor::start()
+
+    bool isAlerting() const { return alerting; }
+    uint8_t getAlertChannel() const { return alertChannel; }
+    uint32_t getChannelTotal(uint8_t channel) const { return channelTotal[channel]; }
+    uint32_t getTotal() const;
+
+    uint16_t getThreshold() const;   // frames/s
+
+    void showMonitor();              // Deauth > Flood Monitor
+
+    void restore(uint8_t type, const uint8_t* data, uint8_t len) override;
+    void snapshot(Journal& journal) override;
+
+private:
+    // Frames and listening time over the last few dwells on one channel
+    struct RateWindow {
+        uint16_t count;
+        uint16_t ms;
+    };
+
+    struct BssidCount {
+        uint8_t bssid[6];
+        uint8_t channel;          // Last heard on
+        bool used;
+        uint16_t dwellCount;      // Frames in the running dwell
+        RateWindow window;
+        uint16_t peakRate;        // frames/s, best dwell so far
+        uint32_t total;
+        unsigned long lastSeen;   // millis() at the end of its last dwell
+    };
+
+    static uint16_t slide(RateWindow& window, uint16_t count, unsigned long dwellMs);
+    void raiseAlert(const uint8_t* bssid, uint8_t channel, uint16_t rate);
+    void stepThreshold(int direction);
+
+    BssidCount bssids[DEAUTH_TRACKED_BSSIDS];
+    uint16_t channelDwellCount[MONITOR_CHANNEL_SLOTS];
+    uint32_t channelTotal[MONITOR_CHANNEL_SLOTS];
+    RateWindow channelWindow[MONITOR_CHANNEL_SLOTS];
+    uint32_t untracked;   // Frames from BSSIDs that found the table full
+    uint8_t thresholdIndex;
+
+    bool alerting;
+    uint8_t alertChannel;
+    uint16_t alertRate;
+    uint8_t alertBssid[6];        // All zero for a channel-wide alert
+    unsigned long lastOverThreshold;
+
+    // Live counters; SELECT starts and stops the monitor, UP/DOWN set the
+    // threshold
+    class MonitorScreen : public Screen {
+    public:
+        explicit MonitorScreen(DeauthDetector& detector) : detector(detector) {}
+        void update(Button btn) override;
+        void render() override;
+        void onEnter() override;
+
+    private:
+        DeauthDetector& detector;
+        unsigned long lastRefresh;
+    };
+
+    MonitorScreen monitorScreen;
+};
+
+extern DeauthDetector deauthDetector;
+
+#endif
@@ -0,0 +1,114 @@
+#include "feedback.h"
+#include "config.h"
+
+static const uint8_t OUT_BUZZER = 0x01;
+static const uint8_t OUT_LED = 0x02;
+static const uint8_t OUT_BOTH = OUT_BUZZER | OUT_LED;
+
+struct FeedbackStep {
+    uint16_t durationMs;    // 0 ends the pattern
+    uint8_t outputs;
+};
+
+static const FeedbackStep PATTERN_CLICK[] PROGMEM = {
+    { 20, OUT_BOTH }, { 0, 0 }
+};
+static const FeedbackStep PATTERN_SUCCESS[] PROGMEM = {
+    { 50, OUT_BOTH }, { 60, 0 }, { 120, OUT_BOTH }, { 0, 0 }
+};
+static const FeedbackStep PATTERN_ERROR[] PROGMEM = {
+    { 200, OUT_BOTH }, { 80, 0 }, { 200, OUT_BOTH }, { 0, 0 }
+};
+static const FeedbackStep PATTERN_ALERT[] PROGMEM = {
+    { 80, OUT_BOTH }, { 80, 0 }, { 80, OUT_BOTH }, { 80, 0 }, { 80, OUT_BOTH }, { 80, 0 },
+    { 80, OUT_BOTH }, { 80, 0 }, { 80, OUT_BOTH }, { 0, 0 }
+};
+
+static const FeedbackStep* const PATTERNS[] = {
+    PATTERN_CLICK, PATTERN_SUCCESS, PATTERN_ERROR, PATTERN_ALERT
+};
+
+Feedback feedback;
+
+Feedback::Feedback() :
+    current(FEEDBACK_NONE),
+    pending(FEEDBACK_NONE),
+    step(0)
+{
+}
+
+void Feedback::begin() {
+    pinMode(BUZZER_PIN, OUTPUT);
+    pinMode(LED_PIN, OUTPUT);
+    setOutputs(0);
+}
+
+// A more important pattern starts at once; anything else except a click
+// waits for the current one. Clicks during a pattern are dropped.
+void Feedback::play(FeedbackPattern pattern) {
+    if (pattern >= FEEDBACK_NONE) {
+        return;
+    }
+    if (current == FEEDBACK_NONE || pattern > current) {
+        startPattern(pattern);
+    } else if (pattern != FEEDBACK_CLICK && (pending == FEEDBACK_NONE || pattern > pending)) {
+        pending = pattern;
+    }
+}
+
+void Feedback::stop() {
+    ticker.detach();
+    setOutputs(0);
+    current = FEEDBACK_NONE;
+    pending = FEEDBACK_NONE;
+}
+
+bool Feedback::toggleBuzzer() {
+    isBuzzerEnabled = !isBuzzerEnabled;
+    snapshot(journal);
+    return isBuzzerEnabled;
+}
+
+void Feedback::restore(uint8_t type, const uint8_t* data, uint8_t len) {
+    if (type == JOURNAL_BUZZER && len == 1) {
+        isBuzzerEnabled = data[0] != 0;
+    }
+}
+
+void Feedback::snapshot(Journal& journal) {
+    uint8_t enabled = isBuzzerEnabled ? 1 : 0;
+    journal.append(JOURNAL_BUZZER, &enabled, sizeof(enabled));
+}
+
+void Feedback::startPattern(FeedbackPattern pattern) {
+    current = pattern;
+    step = 0;
+    nextStep();
+}
+
+// Runs from the Ticker callback, which the SDK calls from its own task
+// between loop() passes, never in the middle of play()
+void Feedback::nextStep() {
+    FeedbackStep s;
+    memcpy_P(&s, &PATTERNS[current][step], sizeof(s));
+
+    if (s.durationMs == 0) {
+        setOutputs(0);
+        FeedbackPattern next = pending;
+        pending = FEEDBACK_NONE;
+        current = FEEDBACK_NONE;
+        if (next != FEEDBACK_NONE) {
+            startPattern(next);
+        }
+        return;
+    }
+
+    setOutputs(s.outputs);
+    step++;
+    ticker.once_ms(s.durationMs, [this]() { nextStep(); });
+}
+
+void Feedback::setOutputs(uint8_t outputs) {
+    digitalWrite(BUZZER_PIN, (outputs & OUT_BUZZER) && isBuzzerEnabled ? HIGH : LOW);
+    digitalWrite(LED_PIN, (outputs & OUT_LED) ? HIGH : LOW);
+}
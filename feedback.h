@@ -0,0 +1,48 @@
+#ifndef FEEDBACK_H
+#define FEEDBACK_H
+
+#include <Arduino.h>
+#include <Ticker.h>
+#include "journal.h"
+
+// Ordered by priority - a pattern never cuts off a more important one
+enum FeedbackPattern : uint8_t {
+    FEEDBACK_CLICK,     // Key press
+    FEEDBACK_SUCCESS,   // Something was saved or deleted
+    FEEDBACK_ERROR,     // Request refused
+    FEEDBACK_ALERT,     // Needs attention now
+    FEEDBACK_NONE
+};
+
+// Plays short on/off patterns on the buzzer and the status LED from a
+// Ticker, so play() returns at once and nothing waits in delay(). The LED
+// follows every pattern; the buzzer only sounds while isBuzzerEnabled,
+// which is kept in the journal.
+class Feedback : public JournalClient {
+public:
+    Feedback();
+
+    void begin();
+    void play(FeedbackPattern pattern);
+    void stop();
+    bool isPlaying() const { return current != FEEDBACK_NONE; }
+
+    bool toggleBuzzer();       // Settings > Buzzer Toggle, returns the new state
+
+    void restore(uint8_t type, const uint8_t* data, uint8_t len) override;
+    void snapshot(Journal& journal) override;
+
+private:
+    void startPattern(FeedbackPattern pattern);
+    void nextStep();
+    void setOutputs(uint8_t outputs);
+
+    Ticker ticker;
+    FeedbackPattern current;
+    FeedbackPattern pending;   // Plays after the current one ends
+    uint8_t step;
+};
+
+extern Feedback feedback;
+
+#endif
@@ -0,0 +1,52 @@
+#include "frame_pacer.h"
+#include "config.h"
+
+static const unsigned long FRAME_INTERVAL_MS = 1000UL / UI_MAX_FPS;
+
+unsigned long FramePacer::lastFrameTime = 0;
+unsigned long FramePacer::frameCount = 0;
+
+FramePacer::FramePacer() :
+    dirty(true),
+    lastDrawTime(0)
+{
+}
+
+void FramePacer::invalidate() {
+    dirty = true;
+}
+
+// Periodic content such as clocks; a frame drawn for any other reason
+// restarts the interval
+void FramePacer::invalidateAfter(unsigned long ms) {
+    if (millis() - lastDrawTime >= ms) {
+        dirty = true;
+    }
+}
+
+bool FramePacer::shouldDraw() {
+    if (!dirty) {
+        return false;
+    }
+
+    unsigned long now = millis();
+    if (frameCount > 0 && now - lastFrameTime < FRAME_INTERVAL_MS) {
+        return false;  // Stays dirty until the budget allows the next frame
+    }
+
+    dirty = false;
+    lastDrawTime = now;
+    lastFrameTime = now;
+    frameCount++;
+    return true;
+}
+
+// delay() rather than yield() so the core can idle the CPU between passes
+// instead of spinning; UI_IDLE_SLICE_MS is well under a button press
+void FramePacer::idle() {
+    delay(UI_IDLE_SLICE_MS);
+}
+
+unsigned long FramePacer::getFrameCount() {
+    return frameCount;
+}
@@ -0,0 +1,28 @@
+#ifndef FRAME_PACER_H
+#define FRAME_PACER_H
+
+#include <Arduino.h>
+
+// Decides when a UI loop redraws. A screen calls invalidate() when a button,
+// new data or an animation step changes what it shows, and only renders
+// when shouldDraw() agrees. All screens share one UI_MAX_FPS frame budget.
+class FramePacer {
+public:
+    FramePacer();  // Starts dirty so a screen draws once on entry
+
+    void invalidate();                       // Redraw on the next allowed frame
+    void invalidateAfter(unsigned long ms);  // Redraw once ms passed since the last frame
+    bool shouldDraw();                       // Dirty and inside the frame budget
+
+    static void idle();                      // End of a loop pass - hand spare time back
+    static unsigned long getFrameCount();
+
+private:
+    bool dirty;
+    unsigned long lastDrawTime;
+
+    static unsigned long lastFrameTime;      // Shared by every screen
+    static unsigned long frameCount;
+};
+
+#endif
@@ -0,0 +1,68 @@
+#include "frame_ring.h"
+
+// Head and tail run freely and wrap at 65536; the slot is the low bits
+static_assert((FRAME_RING_SLOTS & (FRAME_RING_SLOTS - 1)) == 0, "FRAME_RING_SLOTS must be a power of two");
+static_assert(FRAME_RING_SLOTS <= 32768, "FRAME_RING_SLOTS too large for 16-bit indices");
+
+#define FRAME_RING_MASK (FRAME_RING_SLOTS - 1)
+
+// Keeps the compiler from moving slot accesses across an index update.
+// The ESP8266 has one core, so ordering the compiler's output is enough.
+#define RING_BARRIER() __asm__ __volatile__("" ::: "memory")
+
+FrameRing frameRing;
+
+FrameRing::FrameRing() :
+    head(0),
+    tail(0),
+    pushed(0),
+    dropped(0),
+    highWater(0)
+{
+}
+
+bool IRAM_ATTR FrameRing::push(const uint8_t* frame, uint8_t len, int8_t rssi, uint8_t channel) {
+    uint16_t h = head;
+    uint16_t waiting = (uint16_t)(h - tail);
+    if (waiting >= FRAME_RING_SLOTS) {
+        dropped++;
+        return false;
+    }
+
+    FrameSummary& slot = slots[h & FRAME_RING_MASK];
+    slot.timestamp = micros();
+    slot.frameControl[0] = frame[0];
+    slot.frameControl[1] = frame[1];
+    memcpy(slot.addr1, frame + 4, 6);
+    memcpy(slot.addr2, frame + 10, 6);
+    memcpy(slot.addr3, frame + 16, 6);
+    slot.sequence = (uint16_t)((frame[22] | (frame[23] << 8)) >> 4);
+    slot.rssi = rssi;
+    slot.channel = channel;
+#if FRAME_RING_COPY_BYTES > 0
+    slot.headerLen = len < FRAME_RING_COPY_BYTES ? len : FRAME_RING_COPY_BYTES;
+    memcpy(slot.header, frame, slot.headerLen);
+#else
+    (void)len;
+#endif
+
+    RING_BARRIER();
+    head = h + 1;
+    pushed++;
+    if (waiting + 1 > highWater) {
+        highWater = waiting + 1;
+    }
+    return true;
+}
+
+bool FrameRing::pop(FrameSummary& out) {
+    uint16_t t = tail;
+    if (t == head) {
+        return false;
+    }
+    RING_BARRIER();
+    out = slots[t & FRAME_RING_MASK];
+    RING_BARRIER();
+    tail = t + 1;
+    return true;
+}
@@ -0,0 +1,71 @@
+#ifndef FRAME_RING_H
+#define FRAME_RING_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// 802.11 frame control, first byte: subtype << 4 | type << 2
+#define FRAME_TYPE_MASK      0x0C
+#define FRAME_TYPE_MGMT      0x00
+#define FRAME_TYPE_DATA      0x08
+#define FRAME_SUBTYPE_MASK   0xFC
+#define FRAME_DISASSOC       0xA0
+#define FRAME_DEAUTH         0xC0
+
+#define FRAME_HEADER_LEN     24   // Up to and including the sequence number
+
+// What the RX callback keeps of one received frame
+struct FrameSummary {
+    uint32_t timestamp;       // micros() on arrival
+    uint8_t frameControl[2];  // Byte 0: subtype << 4 | type << 2; byte 1: flags
+    uint16_t sequence;        // 12-bit sequence number
+    uint8_t addr1[6];         // Receiver
+    uint8_t addr2[6];         // Transmitter
+    uint8_t addr3[6];         // BSSID for management frames
+    int8_t rssi;
+    uint8_t channel;
+#if FRAME_RING_COPY_BYTES > 0
+    uint8_t headerLen;        // Bytes of header[] in use
+    uint8_t header[FRAME_RING_COPY_BYTES];
+#endif
+
+    uint8_t type() const { return frameControl[0] & FRAME_TYPE_MASK; }
+    uint8_t subtype() const { return frameControl[0] & FRAME_SUBTYPE_MASK; }
+};
+
+// Hands frame summaries from the promiscuous RX callback (the only
+// producer) to loop() (the only consumer) without allocating or locking.
+// Each side owns one index: push() only advances head, pop() only tail,
+// so neither ever waits for the other. A full ring drops the new frame
+// and counts it; the high-water mark shows how close loop() came to
+// falling behind.
+class FrameRing {
+public:
+    FrameRing();
+
+    // RX callback. frame is the start of the 802.11 header, len the header
+    // bytes the SDK passed on (FRAME_HEADER_LEN at least).
+    bool push(const uint8_t* frame, uint8_t len, int8_t rssi, uint8_t channel);
+
+    // loop(). False once the ring is empty.
+    bool pop(FrameSummary& out);
+
+    uint16_t size() const { return (uint16_t)(head - tail); }
+    uint16_t capacity() const { return FRAME_RING_SLOTS; }
+
+    uint32_t getPushed() const { return pushed; }
+    uint32_t getDropped() const { return dropped; }
+    uint16_t getHighWater() const { return highWater; }
+
+private:
+    FrameSummary slots[FRAME_RING_SLOTS];
+    volatile uint16_t head;       // Next slot to write; producer only
+    volatile uint16_t tail;       // Next slot to read; consumer only
+    volatile uint32_t pushed;
+    volatile uint32_t dropped;
+    volatile uint16_t highWater;  // Most summaries waiting at once
+};
+
+extern FrameRing frameRing;
+
+#endif
@@ -0,0 +1,196 @@
+// Host benchmark of the scan processing pipeline: result ingest, vendor
+// lookup, filtering (substring and wildcard SSID patterns) and sorting, each fed the same synthetic environment
+// at several sizes. Per stage it reports host CPU time, virtual time
+// (I2C transfers at 400kHz, delays, and 1 ms per yield()), heap
+// allocations, peak heap above the starting level and I2C bytes sent.
+#include <Arduino.h>
+#include <chrono>
+#include <vector>
+#include "host_platform.h"
+#include "fake_radio.h"
+#include "wifi.h"
+#include "vendor_db.h"
+#include "main_menu.h"
+
+extern "C" {
+#include "user_interface.h"
+}
+
+static const int DEFAULT_SIZES[] = { 20, 100, 500 };
+
+struct StageResult {
+    double hostUs;
+    unsigned long virtualMs;
+    unsigned long allocations;
+    size_t peakBytes;
+    unsigned long i2cBytes;
+};
+
+// Friend of WifiMenu - reaches the private pipeline stages directly
+class PipelineBench {
+public:
+    explicit PipelineBench(int apCount) : count(apCount) {
+        menu.beginStorage(apCount);
+    }
+
+    void ingest(const std::vector<ScanResult>& results) {
+        menu.table.clear();
+        for (size_t i = 0; i < results.size(); i++) {
+            WifiMenu::onScanResult(results[i], &menu);
+        }
+    }
+
+    int lookupVendors(const std::vector<ScanResult>& results) {
+        int known = 0;
+        for (size_t i = 0; i < results.size(); i++) {
+            if (vendorLookup(results[i].bssid) != VENDOR_UNKNOWN) known++;
+        }
+        return known;
+    }
+
+    void filter(const char* pattern) {
+        menu.filterSettings.enabled = true;
+        menu.filterSettings.minSignal = -85;
+        menu.filterSettings.ssidPattern = pattern;
+        menu.filterSettings.ssidMatcher.compile(pattern);
+        menu.view.invalidate();
+        menu.sortNetworks();
+        menu.resetFilters();
+    }
+
+    void sort() {
+        menu.order.setKey(SORT_RSSI);
+        menu.sortNetworks();
+    }
+
+    int size() const {
+        return menu.table.size();
+    }
+
+private:
+    int count;
+    WifiMenu menu;
+};
+
+static std::vector<ScanResult> makeResults(int count, uint32_t seed) {
+    fakeRadioClear();
+    fakeRadioGenerate(count, seed);
+
+    std::vector<ScanResult> results;
+    for (int i = 0; i < fakeRadioApCount(); i++) {
+        const FakeAp& ap = fakeRadioAp(i);
+        ScanResult r;
+        memset(&r, 0, sizeof(r));
+        memcpy(r.bssid, ap.bssid, sizeof(r.bssid));
+        size_t len = strnlen(ap.ssid, sizeof(r.ssid) - 1);
+        memcpy(r.ssid, ap.ssid, len);
+        r.ssid[len] = '\0';
+        r.rssi = ap.rssi;
+        r.channel = ap.channel;
+        switch (ap.authmode) {
+            case AUTH_OPEN:         r.encType = ENC_TYPE_NONE; break;
+            case AUTH_WEP:          r.encType = ENC_TYPE_WEP; break;
+            case AUTH_WPA_PSK:      r.encType = ENC_TYPE_TKIP; break;
+            case AUTH_WPA2_PSK:     r.encType = ENC_TYPE_CCMP; break;
+            default:                r.encType = ENC_TYPE_AUTO; break;
+        }
+        r.isHidden = ap.hidden;
+        results.push_back(r);
+    }
+    return results;
+}
+
+// Run one stage `reps` times and average; setup() runs untimed before each
+template <typename Setup, typename Stage>
+static StageResult measure(int reps, Setup setup, Stage stage) {
+    StageResult total = { 0, 0, 0, 0, 0 };
+    for (int r = 0; r < reps; r++) {
+        setup();
+
+        hostResetAllocStats();
+        hostResetI2cBytes();
+        size_t liveBefore = hostGetAllocStats().liveBytes;
+        unsigned long virtualStart = millis();
+        auto start = std::chrono::steady_clock::now();
+
+        stage();
+
+        auto end = std::chrono::steady_clock::now();
+        HostAllocStats stats = hostGetAllocStats();
+        total.hostUs += std::chrono::duration<double, std::micro>(end - start).count();
+        total.virtualMs += millis() - virtualStart;
+        total.allocations += stats.allocations;
+        total.peakBytes = max(total.peakBytes, stats.peakBytes - liveBefore);
+        total.i2cBytes += hostI2cBytes();
+    }
+
+    total.hostUs /= reps;
+    total.virtualMs /= reps;
+    total.allocations /= reps;
+    total.i2cBytes /= reps;
+    return total;
+}
+
+static void printRow(int aps, const char* stage, const StageResult& r) {
+    printf("%5d  %-8s %12.1f %10lu %10lu %10zu %10lu\n",
+           aps, stage, r.hostUs, r.virtualMs, r.allocations, r.peakBytes, r.i2cBytes);
+}
+
+static void usage(const char* argv0) {
+    fprintf(stderr,
+            "usage: %s [--reps N] [--seed S] [--sizes N,N,...]\n"
+            "  --reps N     repetitions per stage, averaged (default 20)\n"
+            "  --seed S     seed for the synthetic environment (default 1)\n"
+            "  --sizes L    comma separated AP counts (default 20,100,500)\n",
+            argv0);
+}
+
+int main(int argc, char** argv) {
+    int reps = 20;
+    unsigned long seed = 1;
+    std::vector<int> sizes(DEFAULT_SIZES, DEFAULT_SIZES + sizeof(DEFAULT_SIZES) / sizeof(DEFAULT_SIZES[0]));
+
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--reps") == 0 && hasValue) reps = max(1, atoi(argv[++i]));
+        else if (strcmp(argv[i], "--seed") == 0 && hasValue) seed = strtoul(argv[++i], nullptr, 10);
+        else if (strcmp(argv[i], "--sizes") == 0 && hasValue) {
+            sizes.clear();
+            for (char* tok = strtok(argv[++i], ","); tok; tok = strtok(nullptr, ",")) {
+                if (atoi(tok) > 0) sizes.push_back(atoi(tok));
+            }
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    hostSetSerialEcho(false);
+
+    // The stages draw progress and messages, so give them a panel to draw on
+    display.begin(SSD1306_SWITCHCAPVCC, OLED_ADDRESS);
+
+    printf("  APs  stage         host_us    virt_ms     allocs peak_bytes  i2c_bytes\n");
+    for (size_t s = 0; s < sizes.size(); s++) {
+        int aps = sizes[s];
+        std::vector<ScanResult> results = makeResults(aps, (uint32_t)seed);
+        PipelineBench bench(aps);
+
+        StageResult r;
+        r = measure(reps, [&]() {}, [&]() { bench.ingest(results); });
+        printRow(aps, "ingest", r);
+
+        r = measure(reps, [&]() {}, [&]() { bench.lookupVendors(results); });
+        printRow(aps, "vendor", r);
+
+        r = measure(reps, [&]() { bench.ingest(results); bench.sort(); }, [&]() { bench.filter("o"); });
+        printRow(aps, "filter", r);
+
+        r = measure(reps, [&]() { bench.ingest(results); bench.sort(); }, [&]() { bench.filter("*e?_*o*"); });
+        printRow(aps, "glob", r);
+
+        r = measure(reps, [&]() { bench.ingest(results); }, [&]() { bench.sort(); });
+        printRow(aps, "sort", r);
+    }
+    return 0;
+}
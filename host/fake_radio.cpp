@@ -0,0 +1,639 @@
+#include "fake_radio.h"
+#include "host_platform.h"
+#include <ESP8266WiFi.h>
+extern "C" {
+#include "gpio.h"
+}
+#include <vector>
+
+static std::vector<FakeAp> aps;
+static unsigned long channelScans = 0;
+static uint32_t jitterState = 0x1234567;
+
+// Default SDK dwell per channel when the caller leaves scan_time at zero
+static const uint32 DEFAULT_ACTIVE_DWELL_MS = 120;
+static const uint32 DEFAULT_PASSIVE_DWELL_MS = 360;
+
+// ===================== Environment =====================
+void fakeRadioClear() {
+    aps.clear();
+}
+
+void fakeRadioAdd(const FakeAp& ap) {
+    aps.push_back(ap);
+}
+
+int fakeRadioApCount() {
+    return (int)aps.size();
+}
+
+const FakeAp& fakeRadioAp(int index) {
+    return aps[index];
+}
+
+unsigned long fakeRadioChannelScans() {
+    return channelScans;
+}
+
+static int authByName(const char* name) {
+    if (strcmp(name, "OPEN") == 0) return AUTH_OPEN;
+    if (strcmp(name, "WEP") == 0) return AUTH_WEP;
+    if (strcmp(name, "WPA") == 0) return AUTH_WPA_PSK;
+    if (strcmp(name, "WPA2") == 0) return AUTH_WPA2_PSK;
+    if (strcmp(name, "WPA_WPA2") == 0) return AUTH_WPA_WPA2_PSK;
+    return -1;
+}
+
+bool fakeRadioLoad(const char* path) {
+    FILE* f = fopen(path, "r");
+    if (!f) return false;
+    char line[160];
+    while (fgets(line, sizeof(line), f)) {
+        if (line[0] == '#' || line[0] == '\n') continue;
+        line[strcspn(line, "\r\n")] = '\0';
+
+        FakeAp ap;
+        memset(&ap, 0, sizeof(ap));
+        unsigned int b[6];
+        int channel, rssi, hidden, consumed = 0;
+        char auth[12];
+        if (sscanf(line, "%x:%x:%x:%x:%x:%x,%d,%d,%11[^,],%d,%n",
+                   &b[0], &b[1], &b[2], &b[3], &b[4], &b[5],
+                   &channel, &rssi, auth, &hidden, &consumed) < 10 || consumed == 0) {
+            fprintf(stderr, "fake radio: skipping malformed line '%s'\n", line);
+            continue;
+        }
+        int mode = authByName(auth);
+        if (mode < 0) {
+            fprintf(stderr, "fake radio: unknown auth '%s'\n", auth);
+            continue;
+        }
+        for (int i = 0; i < 6; i++) ap.bssid[i] = (uint8_t)b[i];
+        ap.channel = (uint8_t)channel;
+        ap.rssi = (int8_t)rssi;
+        ap.authmode = (uint8_t)mode;
+        ap.hidden = hidden != 0;
+        strncpy(ap.ssid, line + consumed, sizeof(ap.ssid) - 1);
+        aps.push_back(ap);
+    }
+    fclose(f);
+    return true;
+}
+
+void fakeRadioGenerate(int count, uint32_t seed) {
+    static const uint8_t ouis[][3] = {
+        { 0x0C, 0x80, 0x63 }, { 0x18, 0xE8, 0x29 }, { 0x5C, 0xCF, 0x7F },
+        { 0xDC, 0xA6, 0x32 }, { 0x64, 0x09, 0x80 }, { 0x00, 0x18, 0x4D },
+        { 0x12, 0x34, 0x56 }, { 0x9A, 0xBC, 0xDE }
+    };
+    static const char* words[] = {
+        "HOME", "Office", "Guest", "FRITZ!Box", "TP-Link", "NETGEAR", "xfinity",
+        "Cafe", "Lab", "IoT", "Printer", "DIRECT-", "eduroam", "Floor3", "Mesh"
+    };
+    static const uint8_t busyChannels[] = { 1, 6, 11 };
+
+    uint32_t s = seed ? seed : 1;
+    auto next = [&s]() { s = s * 1103515245u + 12345u; return (s >> 8) & 0xFFFFFF; };
+
+    for (int i = 0; i < count; i++) {
+        FakeAp ap;
+        memset(&ap, 0, sizeof(ap));
+        const uint8_t* oui = ouis[next() % (sizeof(ouis) / sizeof(ouis[0]))];
+        ap.bssid[0] = oui[0];
+        ap.bssid[1] = oui[1];
+        ap.bssid[2] = oui[2];
+        uint32_t tail = next();
+        ap.bssid[3] = (uint8_t)(tail >> 16);
+        ap.bssid[4] = (uint8_t)(tail >> 8);
+        ap.bssid[5] = (uint8_t)i;
+
+        ap.channel = (next() % 3) ? busyChannels[next() % 3] : (uint8_t)(1 + next() % 13);
+        ap.rssi = (int8_t)(-35 - (int)(next() % 60));
+        ap.authmode = (uint8_t)(next() % 10 < 2 ? AUTH_OPEN : 1 + next() % 4);
+        ap.hidden = next() % 12 == 0;
+
+        if (!ap.hidden) {
+            // Every fourth AP reuses an earlier SSID, like mesh/extender setups
+            if (i > 0 && next() % 4 == 0) {
+                strcpy(ap.ssid, aps[aps.size() - 1 - next() % std::min<size_t>(aps.size(), 8)].ssid);
+            }
+            if (ap.ssid[0] == '\0') {
+                int len = snprintf(ap.ssid, sizeof(ap.ssid), "%s", words[next() % 15]);
+                int extra = (int)(next() % 4);
+                for (int w = 0; w < extra && len < 28; w++) {
+                    len += snprintf(ap.ssid + len, sizeof(ap.ssid) - len, "_%s", words[next() % 15]);
+                }
+                if (len < 29) snprintf(ap.ssid + len, sizeof(ap.ssid) - len, "%u", (unsigned)(next() % 1000));
+                ap.ssid[32] = '\0';
+            }
+        }
+        aps.push_back(ap);
+    }
+}
+
+// ===================== SDK scan =====================
+static bool scanPending = false;
+static unsigned long scanDueMs = 0;
+static scan_config pendingConfig;
+static scan_done_cb_t pendingCallback = nullptr;
+static std::vector<bss_info> scanResults;
+static bool tickHookInstalled = false;
+static uint8 currentChannel = 1;
+static uint8 opMode = STATION_MODE;
+
+// ===================== RF power accounting =====================
+// The RF front end is powered while a mode is set and no forced sleep
+// holds it off; that is the dominant current draw of the module
+static bool rfForcedOff = false;
+static bool lightSleeping = false;
+static unsigned long rfOnTotalMs = 0;
+static unsigned long rfOnSinceMs = 0;
+static bool rfWasOn = true;
+static unsigned long lightSleepTotalMs = 0;
+
+static void updateRfPower() {
+    bool on = opMode != NULL_MODE && !rfForcedOff && !lightSleeping;
+    unsigned long now = millis();
+    if (rfWasOn) rfOnTotalMs += now - rfOnSinceMs;
+    rfOnSinceMs = now;
+    rfWasOn = on;
+}
+
+unsigned long fakeRadioRfOnMs() {
+    updateRfPower();
+    return rfOnTotalMs;
+}
+
+unsigned long fakeRadioLightSleepMs() {
+    return lightSleepTotalMs;
+}
+
+static void completeScan() {
+    scanResults.clear();
+    for (size_t i = 0; i < aps.size(); i++) {
+        const FakeAp& ap = aps[i];
+        if (pendingConfig.channel && ap.channel != pendingConfig.channel) continue;
+        if (ap.hidden && !pendingConfig.show_hidden) continue;
+
+        bss_info info;
+        memset(&info, 0, sizeof(info));
+        memcpy(info.bssid, ap.bssid, 6);
+        info.ssid_len = (uint8)strnlen(ap.ssid, 32);
+        if (!ap.hidden) memcpy(info.ssid, ap.ssid, info.ssid_len);
+        else info.ssid_len = 0;
+        info.channel = ap.channel;
+        jitterState = jitterState * 1664525u + 1013904223u;
+        info.rssi = (sint8)(ap.rssi + (int)((jitterState >> 24) % 7) - 3);
+        info.authmode = (AUTH_MODE)ap.authmode;
+        info.is_hidden = ap.hidden;
+        scanResults.push_back(info);
+    }
+    for (size_t i = 0; i < scanResults.size(); i++) {
+        scanResults[i].next.stqe_next = i + 1 < scanResults.size() ? &scanResults[i + 1] : nullptr;
+    }
+
+    scanPending = false;
+    scan_done_cb_t cb = pendingCallback;
+    pendingCallback = nullptr;
+    if (cb) cb(scanResults.empty() ? nullptr : &scanResults[0], OK);
+}
+
+static void scanTick(unsigned long nowMs) {
+    if (scanPending && nowMs >= scanDueMs) {
+        completeScan();
+    }
+}
+
+bool wifi_station_scan(struct scan_config* config, scan_done_cb_t cb) {
+    if (scanPending || !(opMode & STATION_MODE) || rfForcedOff) return false;
+    if (!tickHookInstalled) {
+        hostAddTickHook(scanTick);
+        tickHookInstalled = true;
+    }
+
+    memset(&pendingConfig, 0, sizeof(pendingConfig));
+    if (config) pendingConfig = *config;
+    pendingCallback = cb;
+
+    uint32 dwell;
+    if (pendingConfig.scan_type == WIFI_SCAN_TYPE_PASSIVE) {
+        dwell = pendingConfig.scan_time.passive ? pendingConfig.scan_time.passive : DEFAULT_PASSIVE_DWELL_MS;
+    } else {
+        dwell = pendingConfig.scan_time.active.max ? pendingConfig.scan_time.active.max : DEFAULT_ACTIVE_DWELL_MS;
+    }
+    int channels = pendingConfig.channel ? 1 : 13;
+    channelScans += channels;
+    scanDueMs = millis() + dwell * channels;
+    scanPending = true;
+    return true;
+}
+
+bool wifi_set_opmode(uint8 mode) {
+    opMode = mode;
+    updateRfPower();
+    return true;
+}
+
+bool wifi_set_opmode_current(uint8 mode) {
+    opMode = mode;
+    updateRfPower();
+    return true;
+}
+
+uint8 wifi_get_opmode(void) {
+    return opMode;
+}
+
+bool wifi_set_channel(uint8 channel) {
+    if (channel < 1 || channel > 14) return false;
+    currentChannel = channel;
+    return true;
+}
+
+uint8 wifi_get_channel(void) {
+    return currentChannel;
+}
+
+uint32 system_get_time(void) {
+    return (uint32)micros();
+}
+
+// ===================== Promiscuous reception =====================
+// While promiscuous mode is on and the RF is powered, every AP on the
+// current channel beacons each 102 ms and sends some data frames, and any
+// active flood adds spoofed deauths. Frames reach the callback in the
+// SDK's buffer layouts: 128 bytes (RxControl + 112 header bytes) for
+// management frames, 60 bytes (RxControl + 36 header bytes) for data.
+struct HostRxControl {
+    signed rssi:8;
+    unsigned rate:4;
+    unsigned is_group:1;
+    unsigned:1;
+    unsigned sig_mode:2;
+    unsigned legacy_length:12;
+    unsigned damatch0:1;
+    unsigned damatch1:1;
+    unsigned bssidmatch0:1;
+    unsigned bssidmatch1:1;
+    unsigned MCS:7;
+    unsigned CWB:1;
+    unsigned HT_length:16;
+    unsigned Smoothing:1;
+    unsigned Not_Sounding:1;
+    unsigned:1;
+    unsigned Aggregation:1;
+    unsigned STBC:2;
+    unsigned FEC_CODING:1;
+    unsigned SGI:1;
+    unsigned rxend_state:8;
+    unsigned ampdu_cnt:8;
+    unsigned channel:4;
+    unsigned:12;
+};
+
+struct HostSnifferMgmt {
+    HostRxControl rx_ctrl;
+    uint8 buf[112];
+    uint16 cnt;
+    uint16 len;
+};
+
+struct HostSnifferData {
+    HostRxControl rx_ctrl;
+    uint8 buf[36];
+    uint16 cnt;
+    struct {
+        uint16 length;
+        uint16 seq;
+        uint8 address3[6];
+    } lenseq[1];
+};
+
+struct FakeFlood {
+    uint8_t bssid[6];
+    uint8_t channel;
+    unsigned long startMs;
+    unsigned long durationMs;
+    uint16_t rate;
+};
+
+static std::vector<FakeFlood> floods;
+static bool promiscuous = false;
+static wifi_promiscuous_cb_t promiscuousCb = nullptr;
+static bool promiscuousHookInstalled = false;
+static unsigned long rxFrames = 0;
+static uint16_t sequence = 0;
+
+static const uint8_t BROADCAST[6] = { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF };
+
+// True on the milliseconds where a periodic sender at rate/s fires
+static bool fires(unsigned long nowMs, unsigned long phase, unsigned long rate) {
+    unsigned long t = nowMs + phase;
+    return t > 0 && (t * rate) / 1000 != ((t - 1) * rate) / 1000;
+}
+
+static void fillHeader(uint8_t* h, uint8_t frameControl, const uint8_t* dst, const uint8_t* src, const uint8_t* bssid) {
+    h[0] = frameControl;
+    h[1] = 0;
+    h[2] = h[3] = 0;
+    memcpy(h + 4, dst, 6);
+    memcpy(h + 10, src, 6);
+    memcpy(h + 16, bssid, 6);
+    sequence++;
+    h[22] = (uint8_t)(sequence << 4);
+    h[23] = (uint8_t)(sequence >> 4);
+}
+
+static void deliverMgmt(uint8_t frameControl, const uint8_t* bssid, int8_t rssi, uint16_t reason) {
+    HostSnifferMgmt frame;
+    memset(&frame, 0, sizeof(frame));
+    frame.rx_ctrl.rssi = rssi;
+    frame.rx_ctrl.channel = currentChannel;
+    fillHeader(frame.buf, frameControl, BROADCAST, bssid, bssid);
+    frame.buf[24] = (uint8_t)reason;
+    frame.buf[25] = (uint8_t)(reason >> 8);
+    frame.cnt = 1;
+    frame.len = 26;
+    rxFrames++;
+    promiscuousCb((uint8*)&frame, sizeof(frame));
+}
+
+static void deliverData(const FakeAp& ap) {
+    HostSnifferData frame;
+    memset(&frame, 0, sizeof(frame));
+    frame.rx_ctrl.rssi = ap.rssi;
+    frame.rx_ctrl.channel = currentChannel;
+    uint8_t station[6] = { 0x02, 0x00, 0x00, ap.bssid[3], ap.bssid[4], ap.bssid[5] };
+    fillHeader(frame.buf, 0x08, station, ap.bssid, ap.bssid);
+    frame.cnt = 1;
+    frame.lenseq[0].length = 512;
+    memcpy(frame.lenseq[0].address3, ap.bssid, 6);
+    rxFrames++;
+    promiscuousCb((uint8*)&frame, sizeof(frame));
+}
+
+static void promiscuousTick(unsigned long nowMs) {
+    if (!promiscuous || !promiscuousCb || !rfWasOn) return;
+
+    for (size_t i = 0; i < aps.size(); i++) {
+        const FakeAp& ap = aps[i];
+        if (ap.channel != currentChannel) continue;
+        if ((nowMs + ap.bssid[5] * 7) % 102 == 0) {
+            deliverMgmt(0x80, ap.bssid, ap.rssi, 0);  // Beacon
+        }
+        if (fires(nowMs, ap.bssid[4] * 13, 5 + (ap.bssid[5] % 8) * 5)) {
+            deliverData(ap);
+        }
+    }
+    for (size_t i = 0; i < floods.size(); i++) {
+        const FakeFlood& flood = floods[i];
+        if (flood.channel != currentChannel || nowMs < flood.startMs ||
+            nowMs >= flood.startMs + flood.durationMs) continue;
+        if (fires(nowMs - flood.startMs, 0, flood.rate)) {
+            deliverMgmt(0xC0, flood.bssid, -40, 7);  // Deauth, class 3 frame from nonassociated STA
+        }
+    }
+}
+
+void wifi_promiscuous_enable(uint8 enable) {
+    promiscuous = enable != 0;
+    if (!promiscuousHookInstalled) {
+        hostAddTickHook(promiscuousTick);
+        promiscuousHookInstalled = true;
+    }
+}
+
+void wifi_set_promiscuous_rx_cb(wifi_promiscuous_cb_t cb) {
+    promiscuousCb = cb;
+}
+
+void fakeRadioAddFlood(const uint8_t* bssid, uint8_t channel, unsigned long startMs,
+                       unsigned long durationMs, uint16_t framesPerSec) {
+    FakeFlood flood;
+    memcpy(flood.bssid, bssid, 6);
+    flood.channel = channel;
+    flood.startMs = startMs;
+    flood.durationMs = durationMs;
+    flood.rate = framesPerSec;
+    floods.push_back(flood);
+}
+
+bool fakeRadioParseFlood(const char* spec) {
+    unsigned int b[6], channel, rate;
+    unsigned long startMs, durationMs;
+    if (sscanf(spec, "%x:%x:%x:%x:%x:%x,%u,%lu,%lu,%u", &b[0], &b[1], &b[2], &b[3], &b[4], &b[5],
+               &channel, &startMs, &durationMs, &rate) != 10) {
+        return false;
+    }
+    uint8_t bssid[6];
+    for (int i = 0; i < 6; i++) bssid[i] = (uint8_t)b[i];
+    fakeRadioAddFlood(bssid, (uint8_t)channel, startMs, durationMs, (uint16_t)rate);
+    return true;
+}
+
+unsigned long fakeRadioRxFrames() {
+    return rxFrames;
+}
+
+// ===================== Forced sleep =====================
+static sleep_type fpmSleepType = NONE_SLEEP_T;
+static bool fpmOpen = false;
+static fpm_wakeup_cb fpmWakeupCb = nullptr;
+static uint32 wakePinMask = 0;
+
+void wifi_fpm_set_sleep_type(enum sleep_type type) {
+    fpmSleepType = type;
+}
+
+void wifi_fpm_open(void) {
+    fpmOpen = true;
+}
+
+void wifi_fpm_close(void) {
+    fpmOpen = false;
+}
+
+void wifi_fpm_do_wakeup(void) {
+    rfForcedOff = false;
+    updateRfPower();
+}
+
+void wifi_fpm_set_wakeup_cb(fpm_wakeup_cb cb) {
+    fpmWakeupCb = cb;
+}
+
+static bool wakePinLow() {
+    for (uint8_t pin = 0; pin < 17; pin++) {
+        if ((wakePinMask & (1u << pin)) && digitalRead(pin) == LOW) return true;
+    }
+    return false;
+}
+
+// Modem sleep just powers the RF down until wifi_fpm_do_wakeup(). Light
+// sleep needs NULL_MODE like the SDK and holds the CPU here until a wake
+// pin goes low or the time is up; 0xFFFFFFF means no timeout
+sint8 wifi_fpm_do_sleep(uint32 sleep_time_in_us) {
+    if (!fpmOpen) return -1;
+
+    if (fpmSleepType == MODEM_SLEEP_T) {
+        rfForcedOff = true;
+        updateRfPower();
+        return 0;
+    }
+    if (fpmSleepType != LIGHT_SLEEP_T || opMode != NULL_MODE) return -1;
+
+    unsigned long start = millis();
+    bool timed = sleep_time_in_us != 0xFFFFFFF;
+    lightSleeping = true;
+    updateRfPower();
+    while (!wakePinLow() && (!timed || (millis() - start) * 1000 < sleep_time_in_us)) {
+        hostAdvanceMicros(1000);
+    }
+    lightSleeping = false;
+    updateRfPower();
+    lightSleepTotalMs += millis() - start;
+
+    if (fpmWakeupCb) fpmWakeupCb();
+    return 0;
+}
+
+void gpio_pin_wakeup_enable(uint32 i, GPIO_INT_TYPE intr_state) {
+    if (i < 17 && intr_state == GPIO_PIN_INTR_LOLEVEL) wakePinMask |= 1u << i;
+}
+
+void gpio_pin_wakeup_disable(void) {
+    wakePinMask = 0;
+}
+
+// ===================== ESP8266WiFi scan class =====================
+ESP8266WiFiClass WiFi;
+
+static bool arduinoScanStarted = false;
+static bool arduinoScanComplete = false;
+static std::vector<bss_info> arduinoResults;
+
+static void arduinoScanDone(void* result, STATUS status) {
+    arduinoResults.clear();
+    if (status == OK) {
+        for (bss_info* it = (bss_info*)result; it; it = STAILQ_NEXT(it, next)) {
+            arduinoResults.push_back(*it);
+        }
+    }
+    arduinoScanStarted = false;
+    arduinoScanComplete = true;
+}
+
+bool ESP8266WiFiClass::mode(WiFiMode_t m) {
+    return wifi_set_opmode((uint8)m);
+}
+
+WiFiMode_t ESP8266WiFiClass::getMode() {
+    return (WiFiMode_t)wifi_get_opmode();
+}
+
+bool ESP8266WiFiClass::disconnect(bool) {
+    return true;
+}
+
+bool ESP8266WiFiClass::setSleepMode(WiFiSleepType_t) {
+    return true;
+}
+
+// Like the core: the mode is saved and switched off, then restored on wake
+static WiFiMode_t forceSleepLastMode = WIFI_STA;
+
+bool ESP8266WiFiClass::forceSleepBegin(uint32) {
+    forceSleepLastMode = getMode();
+    if (!mode(WIFI_OFF)) return false;
+    wifi_fpm_set_sleep_type(MODEM_SLEEP_T);
+    wifi_fpm_open();
+    return wifi_fpm_do_sleep(0xFFFFFFF) == 0;
+}
+
+bool ESP8266WiFiClass::forceSleepWake() {
+    wifi_fpm_do_wakeup();
+    wifi_fpm_close();
+    return mode(forceSleepLastMode);
+}
+
+int8_t ESP8266WiFiClass::scanNetworks(bool async, bool show_hidden, uint8 channel, uint8* ssid) {
+    if (arduinoScanStarted) return WIFI_SCAN_RUNNING;
+    scanDelete();
+    if (!(wifi_get_opmode() & STATION_MODE)) wifi_set_opmode_current(STATION_MODE);
+
+    scan_config config;
+    memset(&config, 0, sizeof(config));
+    config.ssid = ssid;
+    config.channel = channel;
+    config.show_hidden = show_hidden;
+    if (!wifi_station_scan(&config, arduinoScanDone)) return WIFI_SCAN_FAILED;
+    arduinoScanStarted = true;
+
+    if (async) return WIFI_SCAN_RUNNING;
+    while (!arduinoScanComplete) delay(1);
+    return (int8_t)arduinoResults.size();
+}
+
+int8_t ESP8266WiFiClass::scanComplete() {
+    if (arduinoScanStarted) return WIFI_SCAN_RUNNING;
+    if (arduinoScanComplete) return (int8_t)arduinoResults.size();
+    return WIFI_SCAN_FAILED;
+}
+
+void ESP8266WiFiClass::scanDelete() {
+    arduinoResults.clear();
+    arduinoScanComplete = false;
+}
+
+void* ESP8266WiFiClass::getScanInfoByIndex(int i) {
+    if (i < 0 || (size_t)i >= arduinoResults.size()) return nullptr;
+    return &arduinoResults[i];
+}
+
+String ESP8266WiFiClass::SSID(uint8_t i) {
+    bss_info* it = (bss_info*)getScanInfoByIndex(i);
+    if (!it) return String();
+    return String((const char*)it->ssid, it->ssid_len);
+}
+
+uint8_t ESP8266WiFiClass::encryptionType(uint8_t i) {
+    bss_info* it = (bss_info*)getScanInfoByIndex(i);
+    if (!it) return -1;
+    switch (it->authmode) {
+        case AUTH_OPEN: return ENC_TYPE_NONE;
+        case AUTH_WEP: return ENC_TYPE_WEP;
+        case AUTH_WPA_PSK: return ENC_TYPE_TKIP;
+        case AUTH_WPA2_PSK: return ENC_TYPE_CCMP;
+        case AUTH_WPA_WPA2_PSK: return ENC_TYPE_AUTO;
+        default: return -1;
+    }
+}
+
+int32_t ESP8266WiFiClass::RSSI(uint8_t i) {
+    bss_info* it = (bss_info*)getScanInfoByIndex(i);
+    return it ? it->rssi : 0;
+}
+
+uint8_t* ESP8266WiFiClass::BSSID(uint8_t i) {
+    bss_info* it = (bss_info*)getScanInfoByIndex(i);
+    return it ? it->bssid : nullptr;
+}
+
+String ESP8266WiFiClass::BSSIDstr(uint8_t i) {
+    bss_info* it = (bss_info*)getScanInfoByIndex(i);
+    if (!it) return String();
+    char mac[18];
+    sprintf(mac, "%02X:%02X:%02X:%02X:%02X:%02X",
+            it->bssid[0], it->bssid[1], it->bssid[2], it->bssid[3], it->bssid[4], it->bssid[5]);
+    return String(mac);
+}
+
+int32_t ESP8266WiFiClass::channel(uint8_t i) {
+    bss_info* it = (bss_info*)getScanInfoByIndex(i);
+    return it ? it->channel : 0;
+}
+
+bool ESP8266WiFiClass::isHidden(uint8_t i) {
+    bss_info* it = (bss_info*)getScanInfoByIndex(i);
+    return it ? it->is_hidden != 0 : false;
+}
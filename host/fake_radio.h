@@ -0,0 +1,46 @@
+// Simulated 2.4GHz environment for the host build. Scans return the APs
+// on the requested channels after a realistic per-channel dwell.
+#ifndef FAKE_RADIO_H
+#define FAKE_RADIO_H
+
+#include <stdint.h>
+
+struct FakeAp {
+    uint8_t bssid[6];
+    char ssid[33];
+    uint8_t channel;
+    int8_t rssi;
+    uint8_t authmode;   // AUTH_MODE
+    bool hidden;
+};
+
+void fakeRadioClear();
+void fakeRadioAdd(const FakeAp& ap);
+int fakeRadioApCount();
+const FakeAp& fakeRadioAp(int index);
+
+// CSV lines: bssid,channel,rssi,auth,hidden,ssid
+// auth is OPEN, WEP, WPA, WPA2 or WPA_WPA2; the SSID runs to end of line
+bool fakeRadioLoad(const char* path);
+
+// Populate a synthetic environment: mixed SSID lengths, busy 1/6/11,
+// every auth mode, some hidden APs and some repeated SSIDs
+void fakeRadioGenerate(int count, uint32_t seed);
+
+// Deauth frames spoofed from bssid on a channel, at framesPerSec for
+// durationMs from startMs. Spec form: "bssid,channel,start_ms,duration_ms,rate"
+void fakeRadioAddFlood(const uint8_t* bssid, uint8_t channel, unsigned long startMs,
+                       unsigned long durationMs, uint16_t framesPerSec);
+bool fakeRadioParseFlood(const char* spec);
+
+// Frames handed to the promiscuous RX callback so far
+unsigned long fakeRadioRxFrames();
+
+// Every channel scan the firmware has requested so far
+unsigned long fakeRadioChannelScans();
+
+// Time the RF front end was powered, and time spent in light sleep
+unsigned long fakeRadioRfOnMs();
+unsigned long fakeRadioLightSleepMs();
+
+#endif
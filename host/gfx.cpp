@@ -0,0 +1,255 @@
+#include "Adafruit_SSD1306.h"
+#include "host_platform.h"
+
+// ===================== Adafruit_GFX =====================
+Adafruit_GFX::Adafruit_GFX(int16_t w, int16_t h) :
+    WIDTH(w), HEIGHT(h), _width(w), _height(h), cursorX(0), cursorY(0),
+    textColor(0xFFFF), textBgColor(0xFFFF), textSize(1), wrap(true)
+{
+}
+
+void Adafruit_GFX::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+    for (int16_t i = 0; i < h; i++) drawPixel(x, y + i, color);
+}
+
+void Adafruit_GFX::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+    for (int16_t i = 0; i < w; i++) drawPixel(x + i, y, color);
+}
+
+void Adafruit_GFX::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    for (int16_t i = x; i < x + w; i++) drawFastVLine(i, y, h, color);
+}
+
+void Adafruit_GFX::fillScreen(uint16_t color) {
+    fillRect(0, 0, _width, _height, color);
+}
+
+void Adafruit_GFX::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+    int16_t dx = abs(x1 - x0), sx = x0 < x1 ? 1 : -1;
+    int16_t dy = -abs(y1 - y0), sy = y0 < y1 ? 1 : -1;
+    int16_t err = dx + dy;
+    while (true) {
+        drawPixel(x0, y0, color);
+        if (x0 == x1 && y0 == y1) break;
+        int16_t e2 = 2 * err;
+        if (e2 >= dy) { err += dy; x0 += sx; }
+        if (e2 <= dx) { err += dx; y0 += sy; }
+    }
+}
+
+void Adafruit_GFX::drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    drawFastHLine(x, y, w, color);
+    drawFastHLine(x, y + h - 1, w, color);
+    drawFastVLine(x, y, h, color);
+    drawFastVLine(x + w - 1, y, h, color);
+}
+
+void Adafruit_GFX::drawRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, uint16_t color) {
+    drawFastHLine(x + r, y, w - 2 * r, color);
+    drawFastHLine(x + r, y + h - 1, w - 2 * r, color);
+    drawFastVLine(x, y + r, h - 2 * r, color);
+    drawFastVLine(x + w - 1, y + r, h - 2 * r, color);
+}
+
+void Adafruit_GFX::fillRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, uint16_t color) {
+    fillRect(x + r, y, w - 2 * r, h, color);
+    fillRect(x, y + r, r, h - 2 * r, color);
+    fillRect(x + w - r, y + r, r, h - 2 * r, color);
+}
+
+void Adafruit_GFX::drawCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) {
+    for (int16_t dy = -r; dy <= r; dy++) {
+        for (int16_t dx = -r; dx <= r; dx++) {
+            int d = dx * dx + dy * dy;
+            if (d <= r * r && d > (r - 1) * (r - 1)) drawPixel(x0 + dx, y0 + dy, color);
+        }
+    }
+}
+
+void Adafruit_GFX::fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) {
+    for (int16_t dy = -r; dy <= r; dy++) {
+        for (int16_t dx = -r; dx <= r; dx++) {
+            if (dx * dx + dy * dy <= r * r) drawPixel(x0 + dx, y0 + dy, color);
+        }
+    }
+}
+
+// Placeholder 5x7 glyph: stable per character, blank for space
+static uint8_t glyphColumn(unsigned char c, int column) {
+    if (c == ' ') return 0;
+    uint8_t bits = (uint8_t)(((c * 37u) + column * 91u) ^ (c << column)) & 0x7F;
+    return bits ? bits : 0x41;
+}
+
+void Adafruit_GFX::drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg, uint8_t size) {
+    for (int8_t i = 0; i < 6; i++) {
+        uint8_t line = i < 5 ? glyphColumn(c, i) : 0;
+        for (int8_t j = 0; j < 8; j++, line >>= 1) {
+            if (line & 1) {
+                if (size == 1) drawPixel(x + i, y + j, color);
+                else fillRect(x + i * size, y + j * size, size, size, color);
+            } else if (bg != color) {
+                if (size == 1) drawPixel(x + i, y + j, bg);
+                else fillRect(x + i * size, y + j * size, size, size, bg);
+            }
+        }
+    }
+}
+
+size_t Adafruit_GFX::write(uint8_t c) {
+    if (c == '\n') {
+        cursorX = 0;
+        cursorY += textSize * 8;
+    } else if (c != '\r') {
+        if (wrap && (cursorX + textSize * 6) > _width) {
+            cursorX = 0;
+            cursorY += textSize * 8;
+        }
+        drawChar(cursorX, cursorY, c, textColor, textBgColor, textSize);
+        cursorX += textSize * 6;
+    }
+    return 1;
+}
+
+void Adafruit_GFX::getTextBounds(const char* str, int16_t x, int16_t y, int16_t* x1, int16_t* y1, uint16_t* w, uint16_t* h) {
+    int16_t maxX = x, curX = x, curY = y;
+    int lines = 1;
+    for (const char* p = str; *p; p++) {
+        if (*p == '\n') { curX = x; curY += textSize * 8; lines++; continue; }
+        if (wrap && curX + textSize * 6 > _width) { curX = 0; curY += textSize * 8; lines++; }
+        curX += textSize * 6;
+        if (curX > maxX) maxX = curX;
+    }
+    *x1 = x;
+    *y1 = y;
+    *w = (uint16_t)(maxX - x);
+    *h = (uint16_t)(lines * textSize * 8);
+}
+
+void Adafruit_GFX::getTextBounds(const String& str, int16_t x, int16_t y, int16_t* x1, int16_t* y1, uint16_t* w, uint16_t* h) {
+    getTextBounds(str.c_str(), x, y, x1, y1, w, h);
+}
+
+void Adafruit_GFX::getTextBounds(const __FlashStringHelper* str, int16_t x, int16_t y, int16_t* x1, int16_t* y1, uint16_t* w, uint16_t* h) {
+    getTextBounds(reinterpret_cast<const char*>(str), x, y, x1, y1, w, h);
+}
+
+// ===================== Adafruit_SSD1306 =====================
+Adafruit_SSD1306::Adafruit_SSD1306(uint8_t w, uint8_t h, TwoWire* twi, int8_t, uint32_t clkDuring, uint32_t clkAfter) :
+    Adafruit_GFX(w, h), wire(twi), buffer(nullptr), i2caddr(0x3C), contrast(0xCF),
+    wireClk(clkDuring), restoreClk(clkAfter)
+{
+}
+
+Adafruit_SSD1306::~Adafruit_SSD1306() {
+    if (buffer) hostFree(buffer);
+}
+
+bool Adafruit_SSD1306::begin(uint8_t, uint8_t addr, bool, bool periphBegin) {
+    if (!buffer) {
+        buffer = (uint8_t*)hostMalloc(_width * ((_height + 7) / 8));
+        if (!buffer) return false;
+    }
+    clearDisplay();
+    if (addr) i2caddr = addr;
+    if (periphBegin) wire->begin();
+
+    static const uint8_t init[] = {
+        SSD1306_DISPLAYOFF, SSD1306_MEMORYMODE, 0x00,
+        SSD1306_SETCONTRAST, 0xCF, SSD1306_NORMALDISPLAY, SSD1306_DISPLAYON
+    };
+    ssd1306_commandList(init, sizeof(init));
+    return true;
+}
+
+void Adafruit_SSD1306::ssd1306_command1(uint8_t c) {
+    wire->beginTransmission(i2caddr);
+    wire->write((uint8_t)0x00);
+    wire->write(c);
+    wire->endTransmission();
+}
+
+void Adafruit_SSD1306::ssd1306_commandList(const uint8_t* c, uint8_t n) {
+    wire->beginTransmission(i2caddr);
+    wire->write((uint8_t)0x00);
+    uint16_t bytesOut = 1;
+    while (n--) {
+        if (bytesOut >= BUFFER_LENGTH) {
+            wire->endTransmission();
+            wire->beginTransmission(i2caddr);
+            wire->write((uint8_t)0x00);
+            bytesOut = 1;
+        }
+        wire->write(*c++);
+        bytesOut++;
+    }
+    wire->endTransmission();
+}
+
+void Adafruit_SSD1306::ssd1306_command(uint8_t c) {
+    ssd1306_command1(c);
+}
+
+void Adafruit_SSD1306::display() {
+    static const uint8_t dlist[] = { SSD1306_PAGEADDR, 0, 0xFF, SSD1306_COLUMNADDR, 0 };
+    ssd1306_commandList(dlist, sizeof(dlist));
+    ssd1306_command1(_width - 1);
+
+    uint16_t count = _width * ((_height + 7) / 8);
+    uint8_t* ptr = buffer;
+    wire->beginTransmission(i2caddr);
+    wire->write((uint8_t)0x40);
+    uint16_t bytesOut = 1;
+    while (count--) {
+        if (bytesOut >= BUFFER_LENGTH) {
+            wire->endTransmission();
+            wire->beginTransmission(i2caddr);
+            wire->write((uint8_t)0x40);
+            bytesOut = 1;
+        }
+        wire->write(*ptr++);
+        bytesOut++;
+    }
+    wire->endTransmission();
+}
+
+void Adafruit_SSD1306::clearDisplay() {
+    if (buffer) memset(buffer, 0, _width * ((_height + 7) / 8));
+}
+
+void Adafruit_SSD1306::invertDisplay(bool i) {
+    ssd1306_command1(i ? SSD1306_INVERTDISPLAY : SSD1306_NORMALDISPLAY);
+}
+
+void Adafruit_SSD1306::dim(bool dim) {
+    ssd1306_command1(SSD1306_SETCONTRAST);
+    ssd1306_command1(dim ? 0 : contrast);
+}
+
+void Adafruit_SSD1306::drawPixel(int16_t x, int16_t y, uint16_t color) {
+    if (!buffer || x < 0 || x >= _width || y < 0 || y >= _height) return;
+    uint8_t* b = &buffer[x + (y / 8) * _width];
+    uint8_t bit = 1 << (y & 7);
+    switch (color) {
+        case SSD1306_WHITE: *b |= bit; break;
+        case SSD1306_BLACK: *b &= ~bit; break;
+        case SSD1306_INVERSE: *b ^= bit; break;
+    }
+}
+
+void Adafruit_SSD1306::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+    Adafruit_GFX::drawFastHLine(x, y, w, color);
+}
+
+void Adafruit_SSD1306::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+    Adafruit_GFX::drawFastVLine(x, y, h, color);
+}
+
+bool Adafruit_SSD1306::getPixel(int16_t x, int16_t y) {
+    if (!buffer || x < 0 || x >= _width || y < 0 || y >= _height) return false;
+    return (buffer[x + (y / 8) * _width] >> (y & 7)) & 1;
+}
+
+uint8_t* Adafruit_SSD1306::getBuffer() {
+    return buffer;
+}
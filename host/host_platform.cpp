@@ -0,0 +1,347 @@
+#include "Arduino.h"
+#include "host_platform.h"
+#include "config.h"
+#include <new>
+#include <vector>
+
+// ===================== Virtual clock =====================
+static unsigned long virtualMicros = 0;
+static unsigned long yieldStepMicros = 1000;
+static unsigned long deadlineMs = 0;
+static void (*deadlineHandler)() = nullptr;
+static std::vector<HostTickHook> tickHooks;
+
+static void processButtonScript(unsigned long nowMs);
+
+static unsigned long lastTickMs = 0;
+
+// Run button edges, hooks and the deadline for every millisecond boundary
+// crossed since the last call, in order
+static void runTicks() {
+    unsigned long nowMs = virtualMicros / 1000;
+    while (lastTickMs < nowMs) {
+        lastTickMs++;
+        processButtonScript(lastTickMs);
+        for (size_t i = 0; i < tickHooks.size(); i++) {
+            tickHooks[i](lastTickMs);
+        }
+        if (deadlineHandler && lastTickMs >= deadlineMs) {
+            void (*handler)() = deadlineHandler;
+            deadlineHandler = nullptr;
+            handler();
+        }
+    }
+}
+
+void hostAdvanceMicros(unsigned long us) {
+    unsigned long target = virtualMicros + us;
+    runTicks();
+    // Step a millisecond at a time so events land where they were scheduled
+    while (virtualMicros < target) {
+        unsigned long nextMs = (virtualMicros / 1000 + 1) * 1000;
+        virtualMicros = nextMs < target ? nextMs : target;
+        runTicks();
+    }
+}
+
+void hostBusyMicros(unsigned long us) {
+    virtualMicros += us;
+}
+
+void hostSetYieldStep(unsigned long us) {
+    yieldStepMicros = us;
+}
+
+void hostSetDeadline(unsigned long ms, void (*onDeadline)()) {
+    deadlineMs = ms;
+    deadlineHandler = onDeadline;
+}
+
+void hostAddTickHook(HostTickHook hook) {
+    tickHooks.push_back(hook);
+}
+
+unsigned long millis() {
+    return virtualMicros / 1000;
+}
+
+unsigned long micros() {
+    return virtualMicros;
+}
+
+void delay(unsigned long ms) {
+    hostAdvanceMicros(ms * 1000);
+}
+
+void delayMicroseconds(unsigned int us) {
+    hostAdvanceMicros(us);
+}
+
+void yield() {
+    hostAdvanceMicros(yieldStepMicros);
+}
+
+// ===================== GPIO and scripted buttons =====================
+static const int PIN_COUNT = 17;
+static uint8_t pinLevel[PIN_COUNT];
+// Buttons have external pull-ups, so every pin idles high
+static bool pinLevelInit = (memset(pinLevel, HIGH, sizeof(pinLevel)), true);
+static int pinWriteCount[PIN_COUNT];
+static void (*pinIsr[PIN_COUNT])(void);
+static int pinIsrMode[PIN_COUNT];
+static bool interruptsEnabled = true;
+
+struct ButtonEventScript {
+    unsigned long atMs;
+    uint8_t pin;
+    uint8_t level;
+};
+static std::vector<ButtonEventScript> buttonScript;
+static size_t buttonScriptPos = 0;
+
+static void setPinLevel(uint8_t pin, uint8_t level) {
+    if (pin >= PIN_COUNT || pinLevel[pin] == level) return;
+    uint8_t old = pinLevel[pin];
+    pinLevel[pin] = level;
+    if (!pinIsr[pin] || !interruptsEnabled) return;
+    int mode = pinIsrMode[pin];
+    if (mode == CHANGE || (mode == FALLING && old == HIGH) || (mode == RISING && old == LOW)) {
+        pinIsr[pin]();
+    }
+}
+
+static void processButtonScript(unsigned long nowMs) {
+    while (buttonScriptPos < buttonScript.size() && buttonScript[buttonScriptPos].atMs <= nowMs) {
+        setPinLevel(buttonScript[buttonScriptPos].pin, buttonScript[buttonScriptPos].level);
+        buttonScriptPos++;
+    }
+}
+
+void hostPressButton(uint8_t pin, unsigned long atMs, unsigned long holdMs) {
+    ButtonEventScript press = { atMs, pin, LOW };
+    ButtonEventScript release = { atMs + holdMs, pin, HIGH };
+    // Keep the script ordered; scripts are short so insertion is fine
+    for (ButtonEventScript ev : { press, release }) {
+        std::vector<ButtonEventScript>::iterator it = buttonScript.begin() + buttonScriptPos;
+        while (it != buttonScript.end() && it->atMs <= ev.atMs) ++it;
+        buttonScript.insert(it, ev);
+    }
+}
+
+static int buttonPinByName(const char* name) {
+    if (strcmp(name, "UP") == 0) return BUTTON_UP_PIN;
+    if (strcmp(name, "DOWN") == 0) return BUTTON_DOWN_PIN;
+    if (strcmp(name, "SELECT") == 0) return BUTTON_SELECT_PIN;
+    if (strcmp(name, "BACK") == 0) return BUTTON_BACK_PIN;
+    return -1;
+}
+
+bool hostLoadButtonScript(const char* path) {
+    FILE* f = fopen(path, "r");
+    if (!f) return false;
+    char line[128];
+    while (fgets(line, sizeof(line), f)) {
+        char* hash = strchr(line, '#');
+        if (hash) *hash = '\0';
+        unsigned long atMs = 0, holdMs = 60;
+        char name[16];
+        int fields = sscanf(line, "%lu %15s %lu", &atMs, name, &holdMs);
+        if (fields < 2) continue;
+        int pin = buttonPinByName(name);
+        if (pin < 0) {
+            fprintf(stderr, "button script: unknown button '%s'\n", name);
+            continue;
+        }
+        hostPressButton((uint8_t)pin, atMs, holdMs);
+    }
+    fclose(f);
+    return true;
+}
+
+int hostPinWrites(uint8_t pin) {
+    return pin < PIN_COUNT ? pinWriteCount[pin] : 0;
+}
+
+void pinMode(uint8_t pin, uint8_t mode) {
+    if (pin >= PIN_COUNT) return;
+    if (mode == INPUT_PULLUP) pinLevel[pin] = HIGH;
+}
+
+int digitalRead(uint8_t pin) {
+    return pin < PIN_COUNT ? pinLevel[pin] : LOW;
+}
+
+void digitalWrite(uint8_t pin, uint8_t value) {
+    if (pin >= PIN_COUNT) return;
+    if (pinLevel[pin] != value) pinWriteCount[pin]++;
+    pinLevel[pin] = value;
+}
+
+void analogWrite(uint8_t pin, int value) {
+    digitalWrite(pin, value > 0 ? HIGH : LOW);
+}
+
+void attachInterrupt(uint8_t pin, void (*isr)(void), int mode) {
+    if (pin >= PIN_COUNT) return;
+    pinIsr[pin] = isr;
+    pinIsrMode[pin] = mode;
+}
+
+void detachInterrupt(uint8_t pin) {
+    if (pin < PIN_COUNT) pinIsr[pin] = nullptr;
+}
+
+void noInterrupts() {
+    interruptsEnabled = false;
+}
+
+void interrupts() {
+    interruptsEnabled = true;
+}
+
+// ===================== Random =====================
+static uint32_t randomState = 1;
+
+void randomSeed(unsigned long seed) {
+    randomState = seed ? (uint32_t)seed : 1;
+}
+
+long random(long howBig) {
+    if (howBig <= 0) return 0;
+    randomState = randomState * 1664525u + 1013904223u;
+    return (long)((randomState >> 8) % (uint32_t)howBig);
+}
+
+long random(long howSmall, long howBig) {
+    if (howSmall >= howBig) return howSmall;
+    return howSmall + random(howBig - howSmall);
+}
+
+// ===================== Serial =====================
+HardwareSerial Serial;
+static bool serialEcho = true;
+
+void hostSetSerialEcho(bool enabled) {
+    serialEcho = enabled;
+}
+
+void HardwareSerial::begin(unsigned long) {}
+
+size_t HardwareSerial::write(uint8_t c) {
+    if (serialEcho && c != '\r') fputc(c, stderr);
+    return 1;
+}
+
+size_t HardwareSerial::write(const uint8_t* buffer, size_t size) {
+    for (size_t i = 0; i < size; i++) write(buffer[i]);
+    return size;
+}
+
+// ===================== Heap accounting =====================
+// Every block carries a small header with its size so frees can be
+// attributed; live/peak bytes are payload only, like umm_malloc reports.
+struct AllocHeader {
+    size_t size;
+    size_t pad;
+};
+
+static HostAllocStats allocStats;
+static size_t heapSize = 52 * 1024;
+
+void* hostMalloc(size_t size) {
+    AllocHeader* h = (AllocHeader*)malloc(sizeof(AllocHeader) + size);
+    if (!h) return nullptr;
+    h->size = size;
+    allocStats.allocations++;
+    allocStats.liveBytes += size;
+    if (allocStats.liveBytes > allocStats.peakBytes) allocStats.peakBytes = allocStats.liveBytes;
+    return h + 1;
+}
+
+void hostFree(void* ptr) {
+    if (!ptr) return;
+    AllocHeader* h = (AllocHeader*)ptr - 1;
+    allocStats.frees++;
+    allocStats.liveBytes -= h->size;
+    free(h);
+}
+
+void* hostRealloc(void* ptr, size_t size) {
+    if (!ptr) return hostMalloc(size);
+    AllocHeader* h = (AllocHeader*)ptr - 1;
+    size_t oldSize = h->size;
+    AllocHeader* next = (AllocHeader*)realloc(h, sizeof(AllocHeader) + size);
+    if (!next) return nullptr;
+    next->size = size;
+    // A realloc is a fresh allocation as far as fragmentation goes
+    allocStats.allocations++;
+    allocStats.frees++;
+    allocStats.liveBytes = allocStats.liveBytes - oldSize + size;
+    if (allocStats.liveBytes > allocStats.peakBytes) allocStats.peakBytes = allocStats.liveBytes;
+    return next + 1;
+}
+
+HostAllocStats hostGetAllocStats() {
+    return allocStats;
+}
+
+void hostResetAllocStats() {
+    allocStats.allocations = 0;
+    allocStats.frees = 0;
+    allocStats.peakBytes = allocStats.liveBytes;
+}
+
+void hostSetHeapSize(size_t bytes) {
+    heapSize = bytes;
+}
+
+void* operator new(size_t size) {
+    void* p = hostMalloc(size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    return hostMalloc(size ? size : 1);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    return hostMalloc(size ? size : 1);
+}
+
+void operator delete(void* ptr) noexcept { hostFree(ptr); }
+void operator delete[](void* ptr) noexcept { hostFree(ptr); }
+void operator delete(void* ptr, size_t) noexcept { hostFree(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { hostFree(ptr); }
+
+// ===================== Chip =====================
+EspClass ESP;
+
+uint32_t EspClass::getFreeHeap() {
+    return allocStats.liveBytes < heapSize ? (uint32_t)(heapSize - allocStats.liveBytes) : 0;
+}
+
+uint8_t EspClass::getHeapFragmentation() {
+    return 0;
+}
+
+uint32_t EspClass::getMaxFreeBlockSize() {
+    return getFreeHeap();
+}
+
+uint32_t EspClass::getFreeContStack() {
+    return 4096;
+}
+
+uint32_t EspClass::getCycleCount() {
+    return (uint32_t)(virtualMicros * 80);
+}
+
+void EspClass::restart() {
+    fprintf(stderr, "ESP.restart() called\n");
+    exit(1);
+}
@@ -0,0 +1,61 @@
+// Control surface of the host build: virtual clock, scripted buttons, heap
+// accounting and the simulated OLED panel. Firmware code never includes
+// this; only the host harnesses under host/ do.
+#ifndef HOST_PLATFORM_H
+#define HOST_PLATFORM_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+
+// ===================== Virtual clock =====================
+// millis()/micros() only move when the firmware waits or the bus is busy:
+// yield() costs hostSetYieldStep() microseconds, delay() what it asks for
+// and every I2C byte its time on the wire at 400kHz.
+void hostAdvanceMicros(unsigned long us);
+void hostBusyMicros(unsigned long us); // Time passes, callbacks wait for the next yield
+void hostSetYieldStep(unsigned long us);
+void hostSetDeadline(unsigned long ms, void (*onDeadline)());
+
+typedef void (*HostTickHook)(unsigned long nowMs);
+void hostAddTickHook(HostTickHook hook);
+
+// ===================== Scripted buttons =====================
+// Script lines: "<ms> <UP|DOWN|SELECT|BACK> [hold_ms]", '#' starts a comment
+bool hostLoadButtonScript(const char* path);
+void hostPressButton(uint8_t pin, unsigned long atMs, unsigned long holdMs);
+int hostPinWrites(uint8_t pin);
+
+// ===================== Heap accounting =====================
+struct HostAllocStats {
+    unsigned long allocations;
+    unsigned long frees;
+    size_t liveBytes;
+    size_t peakBytes;
+};
+
+void* hostMalloc(size_t size);
+void* hostRealloc(void* ptr, size_t size);
+void hostFree(void* ptr);
+HostAllocStats hostGetAllocStats();
+void hostResetAllocStats();        // Zero counters, peak restarts from live
+void hostSetHeapSize(size_t bytes); // What ESP.getFreeHeap() counts down from
+
+// ===================== Serial =====================
+void hostSetSerialEcho(bool enabled);
+
+// ===================== I2C / OLED panel =====================
+// The Wire stand-in decodes SSD1306 traffic into a panel image, so what
+// is shown is what was actually sent over the bus.
+unsigned long hostI2cBytes();
+void hostResetI2cBytes();
+const uint8_t* hostPanelMemory(); // 128x64, page-major like SSD1306 GDDRAM
+bool hostPanelOn();
+unsigned long hostPanelOnMs();    // Time the panel was switched on
+void hostDumpPanel(FILE* out);
+
+// ===================== LittleFS image =====================
+void hostSetFsImage(const char* path);
+unsigned long hostFsBytesWritten();  // Bytes written to files since start
+
+#endif
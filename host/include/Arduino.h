@@ -0,0 +1,124 @@
+// Host stand-in for the ESP8266 Arduino core. Only the parts the firmware
+// actually uses are provided; time, GPIO and heap are simulated by
+// host_platform.cpp so runs are deterministic.
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <math.h>
+#include <algorithm>
+#include <functional>
+
+#include "WString.h"
+#include "Print.h"
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+using std::min;
+using std::max;
+
+// ===================== Flash / IRAM attributes =====================
+#define PROGMEM
+#define ICACHE_RAM_ATTR
+#define IRAM_ATTR
+#define ICACHE_FLASH_ATTR
+#define PSTR(s) (s)
+#define PGM_P const char*
+#define pgm_read_byte(addr)  (*(const uint8_t*)(addr))
+#define pgm_read_word(addr)  (*(const uint16_t*)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t*)(addr))
+#define pgm_read_ptr(addr)   (*(const void* const*)(addr))
+#define memcpy_P memcpy
+#define strlen_P strlen
+#define strcmp_P strcmp
+#define strncpy_P strncpy
+
+// ===================== GPIO =====================
+#define LOW  0
+#define HIGH 1
+#define INPUT        0x00
+#define OUTPUT       0x01
+#define INPUT_PULLUP 0x02
+#define RISING  0x01
+#define FALLING 0x02
+#define CHANGE  0x03
+
+// NodeMCU / Wemos pin names
+#define D0 16
+#define D1 5
+#define D2 4
+#define D3 0
+#define D4 2
+#define D5 14
+#define D6 12
+#define D7 13
+#define D8 15
+
+#define DEC 10
+#define HEX 16
+
+#define digitalPinToInterrupt(p) (p)
+
+void pinMode(uint8_t pin, uint8_t mode);
+int digitalRead(uint8_t pin);
+void digitalWrite(uint8_t pin, uint8_t value);
+void analogWrite(uint8_t pin, int value);
+void attachInterrupt(uint8_t pin, void (*isr)(void), int mode);
+void detachInterrupt(uint8_t pin);
+void noInterrupts();
+void interrupts();
+
+// ===================== Timing =====================
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield();
+
+// ===================== Math helpers =====================
+template <typename T, typename L, typename H>
+inline T constrain(T value, L low, H high) {
+    return value < (T)low ? (T)low : (value > (T)high ? (T)high : value);
+}
+
+inline long map(long x, long inMin, long inMax, long outMin, long outMax) {
+    return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+
+long random(long howBig);
+long random(long howSmall, long howBig);
+void randomSeed(unsigned long seed);
+
+// ===================== Serial =====================
+class HardwareSerial : public Print {
+public:
+    void begin(unsigned long baud);
+    int available() { return 0; }
+    int read() { return -1; }
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* buffer, size_t size) override;
+    using Print::write;
+};
+
+extern HardwareSerial Serial;
+
+// ===================== Chip =====================
+class EspClass {
+public:
+    uint32_t getFreeHeap();
+    uint8_t getHeapFragmentation();
+    uint32_t getMaxFreeBlockSize();
+    uint32_t getFreeContStack();
+    uint32_t getChipId() { return 0x00C0FFEE; }
+    uint32_t getCycleCount();
+    void restart();
+};
+
+extern EspClass ESP;
+
+#endif
@@ -0,0 +1,61 @@
+#ifndef HOST_ESP8266WIFI_H
+#define HOST_ESP8266WIFI_H
+
+#include <Arduino.h>
+
+extern "C" {
+#include "user_interface.h"
+}
+
+enum wl_enc_type {
+    ENC_TYPE_WEP  = 5,
+    ENC_TYPE_TKIP = 2,
+    ENC_TYPE_CCMP = 4,
+    ENC_TYPE_NONE = 7,
+    ENC_TYPE_AUTO = 8
+};
+
+#define WIFI_SCAN_RUNNING (-1)
+#define WIFI_SCAN_FAILED  (-2)
+
+typedef enum WiFiMode {
+    WIFI_OFF = 0,
+    WIFI_STA = 1,
+    WIFI_AP = 2,
+    WIFI_AP_STA = 3
+} WiFiMode_t;
+
+typedef enum WiFiSleepType {
+    WIFI_NONE_SLEEP = 0,
+    WIFI_LIGHT_SLEEP = 1,
+    WIFI_MODEM_SLEEP = 2
+} WiFiSleepType_t;
+
+// Scan half of ESP8266WiFiClass, layered on wifi_station_scan() like the
+// real core so both entry points see the same simulated radio.
+class ESP8266WiFiClass {
+public:
+    bool mode(WiFiMode_t m);
+    WiFiMode_t getMode();
+    bool disconnect(bool wifioff = false);
+    bool setSleepMode(WiFiSleepType_t type);
+    bool forceSleepBegin(uint32 sleepUs = 0);
+    bool forceSleepWake();
+
+    int8_t scanNetworks(bool async = false, bool show_hidden = false, uint8 channel = 0, uint8* ssid = nullptr);
+    int8_t scanComplete();
+    void scanDelete();
+
+    String SSID(uint8_t i);
+    uint8_t encryptionType(uint8_t i);
+    int32_t RSSI(uint8_t i);
+    uint8_t* BSSID(uint8_t i);
+    String BSSIDstr(uint8_t i);
+    int32_t channel(uint8_t i);
+    bool isHidden(uint8_t i);
+    void* getScanInfoByIndex(int i);
+};
+
+extern ESP8266WiFiClass WiFi;
+
+#endif
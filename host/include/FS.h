@@ -0,0 +1,52 @@
+#ifndef HOST_FS_H
+#define HOST_FS_H
+
+#include <Arduino.h>
+
+// The slice of the ESP8266 core's fs::FS / fs::File API the firmware uses,
+// over an in-memory flash image (see host/littlefs.cpp). Handles are plain
+// values like the core's, and follow their file through rename().
+namespace fs {
+
+class File {
+public:
+    File() : slot(-1), pos(0), writable(false) {}
+    File(int slot, size_t pos, bool writable) : slot(slot), pos(pos), writable(writable) {}
+
+    explicit operator bool() const { return slot >= 0; }
+
+    size_t write(uint8_t c) { return write(&c, 1); }
+    size_t write(const uint8_t* buf, size_t size);
+    int read();
+    size_t read(uint8_t* buf, size_t size);
+    int available();
+    bool seek(uint32_t pos);
+    size_t position() const { return pos; }
+    size_t size() const;
+    void flush();
+    void close();
+
+private:
+    int slot;
+    size_t pos;
+    bool writable;
+};
+
+class FS {
+public:
+    bool begin();
+    void end();
+    bool format();
+
+    File open(const char* path, const char* mode);
+    bool exists(const char* path);
+    bool remove(const char* path);
+    bool rename(const char* pathFrom, const char* pathTo);
+};
+
+} // namespace fs
+
+using fs::FS;
+using fs::File;
+
+#endif
@@ -0,0 +1,33 @@
+#ifndef HOST_TICKER_H
+#define HOST_TICKER_H
+
+#include <Arduino.h>
+
+// ESP8266 Ticker on the virtual clock. Callbacks run from the millisecond
+// tick, i.e. inside delay()/yield(), like os_timer callbacks on the chip.
+class Ticker {
+public:
+    typedef std::function<void(void)> callback_function_t;
+
+    Ticker();
+    ~Ticker();
+
+    void attach_ms(uint32_t milliseconds, callback_function_t callback);
+    void once_ms(uint32_t milliseconds, callback_function_t callback);
+    void detach();
+    bool active() const { return armed; }
+
+    // Called by the tick hook only
+    void tick(unsigned long nowMs);
+
+private:
+    void arm(uint32_t milliseconds, bool repeat, callback_function_t callback);
+
+    callback_function_t callback;
+    unsigned long dueMs;
+    uint32_t periodMs;
+    bool repeat;
+    bool armed;
+};
+
+#endif
@@ -0,0 +1,27 @@
+#ifndef HOST_WIRE_H
+#define HOST_WIRE_H
+
+#include <Arduino.h>
+
+#define BUFFER_LENGTH 128
+
+class TwoWire : public Print {
+public:
+    void begin();
+    void begin(int sda, int scl);
+    void setClock(uint32_t frequency);
+    void beginTransmission(uint8_t address);
+    uint8_t endTransmission(bool sendStop = true);
+    size_t write(uint8_t data) override;
+    size_t write(const uint8_t* data, size_t size) override;
+    using Print::write;
+
+private:
+    uint8_t txAddress = 0;
+    uint8_t txBuffer[BUFFER_LENGTH];
+    size_t txLength = 0;
+};
+
+extern TwoWire Wire;
+
+#endif
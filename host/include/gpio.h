@@ -0,0 +1,21 @@
+// Host stand-in for the SDK gpio.h wake-up calls used for light sleep
+#ifndef HOST_GPIO_H
+#define HOST_GPIO_H
+
+#include "user_interface.h"
+
+#define GPIO_ID_PIN(n) (n)
+
+typedef enum {
+    GPIO_PIN_INTR_DISABLE = 0,
+    GPIO_PIN_INTR_POSEDGE = 1,
+    GPIO_PIN_INTR_NEGEDGE = 2,
+    GPIO_PIN_INTR_ANYEDGE = 3,
+    GPIO_PIN_INTR_LOLEVEL = 4,
+    GPIO_PIN_INTR_HILEVEL = 5
+} GPIO_INT_TYPE;
+
+void gpio_pin_wakeup_enable(uint32 i, GPIO_INT_TYPE intr_state);
+void gpio_pin_wakeup_disable(void);
+
+#endif
@@ -0,0 +1,119 @@
+// Host stand-in for the subset of the ESP8266 NONOS SDK user_interface.h
+// that the firmware touches. Radio behaviour comes from host/fake_radio.cpp.
+#ifndef HOST_USER_INTERFACE_H
+#define HOST_USER_INTERFACE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef uint8_t uint8;
+typedef int8_t sint8;
+typedef uint16_t uint16;
+typedef int16_t sint16;
+typedef uint32_t uint32;
+typedef int32_t sint32;
+
+#ifndef STAILQ_NEXT
+#define STAILQ_NEXT(elm, field) ((elm)->field.stqe_next)
+#endif
+
+typedef enum {
+    OK = 0,
+    FAIL,
+    PENDING,
+    BUSY,
+    CANCEL
+} STATUS;
+
+typedef enum {
+    AUTH_OPEN = 0,
+    AUTH_WEP,
+    AUTH_WPA_PSK,
+    AUTH_WPA2_PSK,
+    AUTH_WPA_WPA2_PSK,
+    AUTH_MAX
+} AUTH_MODE;
+
+#define NULL_MODE     0x00
+#define STATION_MODE  0x01
+#define SOFTAP_MODE   0x02
+#define STATIONAP_MODE 0x03
+
+// ===================== Scanning =====================
+typedef enum {
+    WIFI_SCAN_TYPE_ACTIVE = 0,
+    WIFI_SCAN_TYPE_PASSIVE
+} wifi_scan_type_t;
+
+typedef struct {
+    uint32 min;
+    uint32 max;
+} wifi_active_scan_time_t;
+
+typedef union {
+    wifi_active_scan_time_t active;
+    uint32 passive;
+} wifi_scan_time_t;
+
+struct scan_config {
+    uint8* ssid;
+    uint8* bssid;
+    uint8 channel;
+    uint8 show_hidden;
+    wifi_scan_type_t scan_type;
+    wifi_scan_time_t scan_time;
+};
+
+struct bss_info {
+    struct {
+        struct bss_info* stqe_next;
+    } next;
+    uint8 bssid[6];
+    uint8 ssid[32];
+    uint8 ssid_len;
+    uint8 channel;
+    sint8 rssi;
+    AUTH_MODE authmode;
+    uint8 is_hidden;
+    sint16 freq_offset;
+    sint16 freqcal_val;
+    uint8* esp_mesh_ie;
+    uint8 simple_pair;
+};
+
+typedef void (*scan_done_cb_t)(void* arg, STATUS status);
+
+bool wifi_station_scan(struct scan_config* config, scan_done_cb_t cb);
+bool wifi_set_opmode(uint8 opmode);
+bool wifi_set_opmode_current(uint8 opmode);
+uint8 wifi_get_opmode(void);
+
+// ===================== Channel / promiscuous mode =====================
+typedef void (*wifi_promiscuous_cb_t)(uint8* buf, uint16 len);
+
+bool wifi_set_channel(uint8 channel);
+uint8 wifi_get_channel(void);
+void wifi_promiscuous_enable(uint8 promiscuous);
+void wifi_set_promiscuous_rx_cb(wifi_promiscuous_cb_t cb);
+
+uint32 system_get_time(void);
+
+// ===================== Forced sleep =====================
+// The host sleeps synchronously inside wifi_fpm_do_sleep(); on the chip it
+// starts at the next idle point (delay()) and ends the same way.
+enum sleep_type {
+    NONE_SLEEP_T = 0,
+    LIGHT_SLEEP_T,
+    MODEM_SLEEP_T
+};
+
+typedef void (*fpm_wakeup_cb)(void);
+
+void wifi_fpm_set_sleep_type(enum sleep_type type);
+void wifi_fpm_open(void);
+void wifi_fpm_close(void);
+void wifi_fpm_do_wakeup(void);
+sint8 wifi_fpm_do_sleep(uint32 sleep_time_in_us);
+void wifi_fpm_set_wakeup_cb(fpm_wakeup_cb cb);
+
+#endif
@@ -0,0 +1,213 @@
+#include "LittleFS.h"
+#include "host_platform.h"
+
+// Files live in plain malloc() blocks - they stand for flash, so they stay
+// out of the firmware's heap accounting. With an image path set the whole
+// filesystem is loaded on begin() and written back on every flush, close,
+// rename and remove, i.e. whenever LittleFS would commit metadata.
+#define HOST_FS_MAX_FILES 16
+#define HOST_FS_MAX_NAME  32
+
+struct HostFsFile {
+    bool used;
+    char name[HOST_FS_MAX_NAME];
+    uint8_t* data;
+    size_t size;
+    size_t capacity;
+};
+
+fs::FS LittleFS;
+
+static HostFsFile files[HOST_FS_MAX_FILES];
+static const char* imagePath = nullptr;
+static bool mounted = false;
+static unsigned long bytesWritten = 0;
+
+void hostSetFsImage(const char* path) {
+    imagePath = path;
+}
+
+unsigned long hostFsBytesWritten() {
+    return bytesWritten;
+}
+
+static void freeSlot(int slot) {
+    free(files[slot].data);
+    memset(&files[slot], 0, sizeof(files[slot]));
+}
+
+static int findSlot(const char* path) {
+    for (int i = 0; i < HOST_FS_MAX_FILES; i++) {
+        if (files[i].used && strcmp(files[i].name, path) == 0) return i;
+    }
+    return -1;
+}
+
+static int createSlot(const char* path) {
+    if (strlen(path) >= HOST_FS_MAX_NAME) return -1;
+    for (int i = 0; i < HOST_FS_MAX_FILES; i++) {
+        if (!files[i].used) {
+            files[i].used = true;
+            strcpy(files[i].name, path);
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Image: per file a name length byte, the name, a 32-bit size, the data
+static void saveImage() {
+    if (!imagePath) return;
+    FILE* f = fopen(imagePath, "wb");
+    if (!f) return;
+    for (int i = 0; i < HOST_FS_MAX_FILES; i++) {
+        if (!files[i].used) continue;
+        uint8_t nameLen = (uint8_t)strlen(files[i].name);
+        uint32_t size = (uint32_t)files[i].size;
+        fwrite(&nameLen, 1, 1, f);
+        fwrite(files[i].name, 1, nameLen, f);
+        fwrite(&size, sizeof(size), 1, f);
+        if (size) fwrite(files[i].data, 1, size, f);
+    }
+    fclose(f);
+}
+
+static void loadImage() {
+    if (!imagePath) return;
+    FILE* f = fopen(imagePath, "rb");
+    if (!f) return;
+    uint8_t nameLen;
+    while (fread(&nameLen, 1, 1, f) == 1) {
+        char name[256];
+        uint32_t size;
+        if (fread(name, 1, nameLen, f) != nameLen || fread(&size, sizeof(size), 1, f) != 1) break;
+        name[nameLen] = '\0';
+        int slot = createSlot(name);
+        if (slot < 0) break;
+        files[slot].data = (uint8_t*)malloc(size ? size : 1);
+        files[slot].capacity = size;
+        files[slot].size = fread(files[slot].data, 1, size, f);
+    }
+    fclose(f);
+}
+
+namespace fs {
+
+// ===== FS =====
+
+bool FS::begin() {
+    if (!mounted) {
+        for (int i = 0; i < HOST_FS_MAX_FILES; i++) freeSlot(i);
+        loadImage();
+        mounted = true;
+    }
+    return true;
+}
+
+void FS::end() {
+    mounted = false;
+}
+
+bool FS::format() {
+    for (int i = 0; i < HOST_FS_MAX_FILES; i++) freeSlot(i);
+    saveImage();
+    return true;
+}
+
+File FS::open(const char* path, const char* mode) {
+    if (!mounted) return File();
+    int slot = findSlot(path);
+    if (mode[0] == 'r') {
+        if (slot < 0) return File();
+        return File(slot, 0, mode[1] == '+');
+    }
+    if (slot < 0) slot = createSlot(path);
+    if (slot < 0) return File();
+    if (mode[0] == 'w') {
+        files[slot].size = 0;
+        return File(slot, 0, true);
+    }
+    return File(slot, files[slot].size, true);  // "a"
+}
+
+bool FS::exists(const char* path) {
+    return mounted && findSlot(path) >= 0;
+}
+
+bool FS::remove(const char* path) {
+    int slot = mounted ? findSlot(path) : -1;
+    if (slot < 0) return false;
+    freeSlot(slot);
+    saveImage();
+    return true;
+}
+
+// Replaces an existing target in one step, like lfs_rename()
+bool FS::rename(const char* pathFrom, const char* pathTo) {
+    int from = mounted ? findSlot(pathFrom) : -1;
+    if (from < 0 || strlen(pathTo) >= HOST_FS_MAX_NAME) return false;
+    int to = findSlot(pathTo);
+    if (to >= 0 && to != from) freeSlot(to);
+    strcpy(files[from].name, pathTo);
+    saveImage();
+    return true;
+}
+
+// ===== File =====
+
+size_t File::write(const uint8_t* buf, size_t len) {
+    if (slot < 0 || !writable) return 0;
+    HostFsFile& file = files[slot];
+    if (pos + len > file.capacity) {
+        size_t capacity = file.capacity ? file.capacity : 256;
+        while (capacity < pos + len) capacity *= 2;
+        file.data = (uint8_t*)realloc(file.data, capacity);
+        file.capacity = capacity;
+    }
+    memcpy(file.data + pos, buf, len);
+    pos += len;
+    if (pos > file.size) file.size = pos;
+    bytesWritten += len;
+    return len;
+}
+
+int File::read() {
+    uint8_t c;
+    return read(&c, 1) == 1 ? c : -1;
+}
+
+size_t File::read(uint8_t* buf, size_t len) {
+    if (slot < 0) return 0;
+    const HostFsFile& file = files[slot];
+    size_t left = pos < file.size ? file.size - pos : 0;
+    if (len > left) len = left;
+    memcpy(buf, file.data + pos, len);
+    pos += len;
+    return len;
+}
+
+int File::available() {
+    if (slot < 0) return 0;
+    return pos < files[slot].size ? (int)(files[slot].size - pos) : 0;
+}
+
+bool File::seek(uint32_t to) {
+    if (slot < 0 || to > files[slot].size) return false;
+    pos = to;
+    return true;
+}
+
+size_t File::size() const {
+    return slot >= 0 ? files[slot].size : 0;
+}
+
+void File::flush() {
+    if (slot >= 0 && writable) saveImage();
+}
+
+void File::close() {
+    flush();
+    slot = -1;
+}
+
+} // namespace fs
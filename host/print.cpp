@@ -0,0 +1,72 @@
+#include "Arduino.h"
+#include <stdarg.h>
+
+size_t Print::write(const uint8_t* buffer, size_t size) {
+    size_t n = 0;
+    while (size--) {
+        n += write(*buffer++);
+    }
+    return n;
+}
+
+size_t Print::print(const __FlashStringHelper* str) {
+    return write(reinterpret_cast<const char*>(str));
+}
+
+size_t Print::print(const String& str) {
+    return write(str.c_str(), str.length());
+}
+
+size_t Print::print(const char* str) {
+    return write(str);
+}
+
+size_t Print::print(char c) {
+    return write((uint8_t)c);
+}
+
+size_t Print::print(unsigned char value, int base) {
+    return print((unsigned long)value, base);
+}
+
+size_t Print::print(int value, int base) {
+    return print((long)value, base);
+}
+
+size_t Print::print(unsigned int value, int base) {
+    return print((unsigned long)value, base);
+}
+
+size_t Print::print(long value, int base) {
+    char buf[24];
+    if (base == 16) snprintf(buf, sizeof(buf), "%lx", value);
+    else snprintf(buf, sizeof(buf), "%ld", value);
+    return write(buf);
+}
+
+size_t Print::print(unsigned long value, int base) {
+    char buf[24];
+    if (base == 16) snprintf(buf, sizeof(buf), "%lx", value);
+    else snprintf(buf, sizeof(buf), "%lu", value);
+    return write(buf);
+}
+
+size_t Print::print(double value, int digits) {
+    char buf[40];
+    snprintf(buf, sizeof(buf), "%.*f", digits, value);
+    return write(buf);
+}
+
+size_t Print::println() {
+    return write("\r\n");
+}
+
+size_t Print::printf(const char* format, ...) {
+    char buf[256];
+    va_list args;
+    va_start(args, format);
+    int n = vsnprintf(buf, sizeof(buf), format, args);
+    va_end(args);
+    if (n < 0) return 0;
+    return write((const uint8_t*)buf, std::min((size_t)n, sizeof(buf) - 1));
+}
@@ -0,0 +1,93 @@
+// Runs the unmodified sketch (setup()/loop()) against the simulated board:
+// fake radio, scripted buttons, LittleFS image file and a decoded OLED panel.
+#include <Arduino.h>
+#include "host_platform.h"
+#include "fake_radio.h"
+#include "frame_pacer.h"
+
+void setup();
+void loop();
+
+static bool dumpPanel = false;
+
+static void finish() {
+    HostAllocStats stats = hostGetAllocStats();
+    fprintf(stdout, "sim: t=%lums frames=%lu i2c_bytes=%lu channel_scans=%lu allocs=%lu frees=%lu live=%zu peak=%zu"
+            " rf_on=%lums panel_on=%lums light_sleep=%lums fs_bytes=%lu rx_frames=%lu\n",
+            millis(), FramePacer::getFrameCount(), hostI2cBytes(), fakeRadioChannelScans(),
+            stats.allocations, stats.frees, stats.liveBytes, stats.peakBytes,
+            fakeRadioRfOnMs(), hostPanelOnMs(), fakeRadioLightSleepMs(), hostFsBytesWritten(),
+            fakeRadioRxFrames());
+    if (dumpPanel) hostDumpPanel(stdout);
+    fflush(stdout);
+    exit(0);
+}
+
+static void usage(const char* argv0) {
+    fprintf(stderr,
+            "usage: %s [options]\n"
+            "  --scenario FILE   APs to simulate (bssid,channel,rssi,auth,hidden,ssid)\n"
+            "  --generate N      synthesize N APs instead (default 30)\n"
+            "  --seed S          seed for --generate\n"
+            "  --buttons FILE    button script (<ms> <UP|DOWN|SELECT|BACK> [hold_ms])\n"
+            "  --flood SPEC      deauth flood: bssid,channel,start_ms,duration_ms,rate\n"
+            "  --fs FILE         LittleFS image, created on first write\n"
+            "  --run MS          virtual milliseconds to run (default 10000)\n"
+            "  --dump            print the final panel contents\n"
+            "  --quiet           silence the firmware's Serial output\n",
+            argv0);
+}
+
+int main(int argc, char** argv) {
+    const char* scenario = nullptr;
+    int generate = 30;
+    unsigned long seed = 1;
+    unsigned long runMs = 10000;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (strcmp(arg, "--scenario") == 0 && hasValue) scenario = argv[++i];
+        else if (strcmp(arg, "--generate") == 0 && hasValue) generate = atoi(argv[++i]);
+        else if (strcmp(arg, "--seed") == 0 && hasValue) seed = strtoul(argv[++i], nullptr, 10);
+        else if (strcmp(arg, "--buttons") == 0 && hasValue) {
+            if (!hostLoadButtonScript(argv[++i])) {
+                fprintf(stderr, "cannot read button script %s\n", argv[i]);
+                return 2;
+            }
+        }
+        else if (strcmp(arg, "--flood") == 0 && hasValue) {
+            if (!fakeRadioParseFlood(argv[++i])) {
+                fprintf(stderr, "bad flood spec %s\n", argv[i]);
+                return 2;
+            }
+        }
+        else if (strcmp(arg, "--fs") == 0 && hasValue) hostSetFsImage(argv[++i]);
+        else if (strcmp(arg, "--run") == 0 && hasValue) runMs = strtoul(argv[++i], nullptr, 10);
+        else if (strcmp(arg, "--dump") == 0) dumpPanel = true;
+        else if (strcmp(arg, "--quiet") == 0) hostSetSerialEcho(false);
+        else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    if (scenario) {
+        if (!fakeRadioLoad(scenario)) {
+            fprintf(stderr, "cannot read scenario %s\n", scenario);
+            return 2;
+        }
+    } else {
+        fakeRadioGenerate(generate, (uint32_t)seed);
+    }
+
+    // The firmware's nested UI loops never return on their own, so the
+    // run ends from inside the virtual clock
+    hostSetDeadline(runMs, finish);
+
+    setup();
+    for (;;) {
+        loop();
+        yield();
+    }
+}
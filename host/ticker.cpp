@@ -0,0 +1,73 @@
+#include "Ticker.h"
+#include "host_platform.h"
+#include <vector>
+
+static std::vector<Ticker*> armedTickers;
+static bool tickHookInstalled = false;
+
+static void tickerTick(unsigned long nowMs) {
+    // A callback may detach or re-arm tickers, which moves entries; only
+    // step on when the current one stayed where it was
+    for (size_t i = 0; i < armedTickers.size(); ) {
+        Ticker* ticker = armedTickers[i];
+        ticker->tick(nowMs);
+        if (i < armedTickers.size() && armedTickers[i] == ticker) i++;
+    }
+}
+
+Ticker::Ticker() :
+    dueMs(0),
+    periodMs(0),
+    repeat(false),
+    armed(false)
+{
+}
+
+Ticker::~Ticker() {
+    detach();
+}
+
+void Ticker::attach_ms(uint32_t milliseconds, callback_function_t cb) {
+    arm(milliseconds, true, cb);
+}
+
+void Ticker::once_ms(uint32_t milliseconds, callback_function_t cb) {
+    arm(milliseconds, false, cb);
+}
+
+void Ticker::arm(uint32_t milliseconds, bool repeating, callback_function_t cb) {
+    if (!tickHookInstalled) {
+        hostAddTickHook(tickerTick);
+        tickHookInstalled = true;
+    }
+    detach();
+    callback = cb;
+    periodMs = milliseconds > 0 ? milliseconds : 1;
+    dueMs = millis() + periodMs;
+    repeat = repeating;
+    armed = true;
+    armedTickers.push_back(this);
+}
+
+void Ticker::detach() {
+    if (!armed) return;
+    armed = false;
+    for (size_t i = 0; i < armedTickers.size(); i++) {
+        if (armedTickers[i] == this) {
+            armedTickers.erase(armedTickers.begin() + i);
+            break;
+        }
+    }
+}
+
+void Ticker::tick(unsigned long nowMs) {
+    if (nowMs < dueMs) return;
+
+    callback_function_t cb = callback;
+    if (repeat) {
+        dueMs += periodMs;
+    } else {
+        detach();
+    }
+    cb();
+}
@@ -0,0 +1,159 @@
+#include "Wire.h"
+#include "host_platform.h"
+
+TwoWire Wire;
+
+// ===================== SSD1306 panel model =====================
+// Horizontal addressing mode only, which is what the firmware uses.
+static uint8_t gddram[128 * 8];
+static bool panelOn = false;
+static bool panelInverted = false;
+static uint8_t panelContrast = 0xCF;
+static uint8_t colStart = 0, colEnd = 127, pageStart = 0, pageEnd = 7;
+static uint8_t col = 0, page = 0;
+static unsigned long i2cBytes = 0;
+static uint32_t busClock = 400000;
+static unsigned long panelOnTotalMs = 0;
+static unsigned long panelOnSinceMs = 0;
+
+static void setPanelOn(bool on) {
+    unsigned long now = millis();
+    if (panelOn) panelOnTotalMs += now - panelOnSinceMs;
+    panelOnSinceMs = now;
+    panelOn = on;
+}
+
+static uint8_t pendingCommand = 0;
+static int pendingArgs = 0;
+static uint8_t args[2];
+static int argIndex = 0;
+
+static int commandArgCount(uint8_t cmd) {
+    switch (cmd) {
+        case 0x21: case 0x22: return 2;             // Column / page address
+        case 0x20: case 0x81: case 0x8D: case 0xA8:  // Mode, contrast, pump, mux
+        case 0xD3: case 0xD5: case 0xD9: case 0xDA: case 0xDB:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+static void applyCommand(uint8_t cmd) {
+    switch (cmd) {
+        case 0x21:
+            colStart = args[0] & 0x7F; colEnd = args[1] & 0x7F; col = colStart;
+            break;
+        case 0x22:
+            pageStart = args[0] & 0x07; pageEnd = args[1] & 0x07; page = pageStart;
+            break;
+        case 0x81: panelContrast = args[0]; break;
+        case 0xAE: setPanelOn(false); break;
+        case 0xAF: setPanelOn(true); break;
+        case 0xA6: panelInverted = false; break;
+        case 0xA7: panelInverted = true; break;
+        default: break;
+    }
+}
+
+static void commandByte(uint8_t b) {
+    if (pendingArgs > 0) {
+        args[argIndex++] = b;
+        if (--pendingArgs == 0) applyCommand(pendingCommand);
+        return;
+    }
+    pendingCommand = b;
+    argIndex = 0;
+    pendingArgs = commandArgCount(b);
+    if (pendingArgs == 0) applyCommand(b);
+}
+
+static void dataByte(uint8_t b) {
+    gddram[page * 128 + col] = b;
+    if (col >= colEnd) {
+        col = colStart;
+        page = page >= pageEnd ? pageStart : page + 1;
+    } else {
+        col++;
+    }
+}
+
+void TwoWire::begin() {}
+void TwoWire::begin(int, int) {}
+void TwoWire::setClock(uint32_t frequency) {
+    if (frequency) busClock = frequency;
+}
+
+void TwoWire::beginTransmission(uint8_t address) {
+    txAddress = address;
+    txLength = 0;
+}
+
+uint8_t TwoWire::endTransmission(bool) {
+    i2cBytes += txLength + 1; // Payload plus the address byte
+    // Start, 9 clocks per byte (ack included) and stop
+    hostBusyMicros(((txLength + 1) * 9 + 2) * 1000000UL / busClock);
+    if (txLength > 0) {
+        bool isData = (txBuffer[0] & 0x40) != 0;
+        for (size_t i = 1; i < txLength; i++) {
+            if (isData) dataByte(txBuffer[i]);
+            else commandByte(txBuffer[i]);
+        }
+    }
+    txLength = 0;
+    return 0;
+}
+
+size_t TwoWire::write(uint8_t data) {
+    if (txLength >= BUFFER_LENGTH) return 0;
+    txBuffer[txLength++] = data;
+    return 1;
+}
+
+size_t TwoWire::write(const uint8_t* data, size_t size) {
+    size_t n = 0;
+    while (n < size && write(data[n])) n++;
+    return n;
+}
+
+unsigned long hostI2cBytes() {
+    return i2cBytes;
+}
+
+void hostResetI2cBytes() {
+    i2cBytes = 0;
+}
+
+const uint8_t* hostPanelMemory() {
+    return gddram;
+}
+
+bool hostPanelOn() {
+    return panelOn;
+}
+
+unsigned long hostPanelOnMs() {
+    setPanelOn(panelOn);
+    return panelOnTotalMs;
+}
+
+// ASCII-art dump of what the panel currently shows, two rows per line
+void hostDumpPanel(FILE* out) {
+    fprintf(out, "+");
+    for (int x = 0; x < 128; x++) fputc('-', out);
+    fprintf(out, "+ %s contrast=%u\n", panelOn ? "on" : "off", panelContrast);
+    for (int y = 0; y < 64; y += 2) {
+        fputc('|', out);
+        for (int x = 0; x < 128; x++) {
+            bool top = (gddram[(y / 8) * 128 + x] >> (y % 8)) & 1;
+            bool bottom = (gddram[((y + 1) / 8) * 128 + x] >> ((y + 1) % 8)) & 1;
+            if (panelInverted) { top = !top; bottom = !bottom; }
+            if (!panelOn) { top = bottom = false; }
+            fputc(top && bottom ? '#' : (top ? '\'' : (bottom ? '.' : ' ')), out);
+        }
+        fprintf(out, "|\n");
+    }
+    fprintf(out, "+");
+    for (int x = 0; x < 128; x++) fputc('-', out);
+    fprintf(out, "+\n");
+}
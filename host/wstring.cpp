@@ -0,0 +1,292 @@
+#include "Arduino.h"
+#include "host_platform.h"
+#include <ctype.h>
+
+String::String(const char* cstr) : buffer(nullptr), capacity(0), len(0) {
+    if (cstr) assign(cstr, strlen(cstr));
+}
+
+String::String(const char* cstr, unsigned int length) : buffer(nullptr), capacity(0), len(0) {
+    if (cstr) assign(cstr, length);
+}
+
+String::String(const __FlashStringHelper* str) : buffer(nullptr), capacity(0), len(0) {
+    const char* cstr = reinterpret_cast<const char*>(str);
+    if (cstr) assign(cstr, strlen(cstr));
+}
+
+String::String(const String& other) : buffer(nullptr), capacity(0), len(0) {
+    assign(other.c_str(), other.len);
+}
+
+String::String(String&& other) noexcept
+    : buffer(other.buffer), capacity(other.capacity), len(other.len) {
+    other.buffer = nullptr;
+    other.capacity = 0;
+    other.len = 0;
+}
+
+String::String(char c) : buffer(nullptr), capacity(0), len(0) {
+    assign(&c, 1);
+}
+
+static void formatNumber(char* out, size_t size, unsigned long value, bool negative, unsigned char base) {
+    char digits[34];
+    int pos = 0;
+    do {
+        int d = value % base;
+        digits[pos++] = (char)(d < 10 ? '0' + d : 'a' + d - 10);
+        value /= base;
+    } while (value && pos < 33);
+    size_t o = 0;
+    if (negative && o + 1 < size) out[o++] = '-';
+    while (pos > 0 && o + 1 < size) out[o++] = digits[--pos];
+    out[o] = '\0';
+}
+
+String::String(unsigned char value, unsigned char base) : String((unsigned long)value, base) {}
+String::String(int value, unsigned char base) : String((long)value, base) {}
+String::String(unsigned int value, unsigned char base) : String((unsigned long)value, base) {}
+
+String::String(long value, unsigned char base) : buffer(nullptr), capacity(0), len(0) {
+    char buf[36];
+    if (base == 10 && value < 0) {
+        formatNumber(buf, sizeof(buf), (unsigned long)(-value), true, base);
+    } else {
+        formatNumber(buf, sizeof(buf), (unsigned long)value, false, base);
+    }
+    assign(buf, strlen(buf));
+}
+
+String::String(unsigned long value, unsigned char base) : buffer(nullptr), capacity(0), len(0) {
+    char buf[36];
+    formatNumber(buf, sizeof(buf), value, false, base);
+    assign(buf, strlen(buf));
+}
+
+String::String(float value, unsigned char decimals) : String((double)value, decimals) {}
+
+String::String(double value, unsigned char decimals) : buffer(nullptr), capacity(0), len(0) {
+    char buf[40];
+    snprintf(buf, sizeof(buf), "%.*f", decimals, value);
+    assign(buf, strlen(buf));
+}
+
+String::~String() {
+    if (buffer) hostFree(buffer);
+}
+
+String& String::operator=(const String& rhs) {
+    if (this != &rhs) assign(rhs.c_str(), rhs.len);
+    return *this;
+}
+
+String& String::operator=(String&& rhs) noexcept {
+    if (this != &rhs) {
+        if (buffer) hostFree(buffer);
+        buffer = rhs.buffer;
+        capacity = rhs.capacity;
+        len = rhs.len;
+        rhs.buffer = nullptr;
+        rhs.capacity = 0;
+        rhs.len = 0;
+    }
+    return *this;
+}
+
+String& String::operator=(const char* cstr) {
+    if (cstr) assign(cstr, strlen(cstr));
+    else assign("", 0);
+    return *this;
+}
+
+String& String::operator=(const __FlashStringHelper* str) {
+    return *this = reinterpret_cast<const char*>(str);
+}
+
+bool String::grow(unsigned int size) {
+    if (buffer && capacity >= size) return true;
+    char* next = (char*)hostRealloc(buffer, size + 1);
+    if (!next) return false;
+    if (!buffer) next[0] = '\0';
+    buffer = next;
+    capacity = size;
+    return true;
+}
+
+bool String::reserve(unsigned int size) {
+    return grow(size);
+}
+
+// Like the real core, an empty assignment keeps (or skips) the buffer
+void String::assign(const char* cstr, unsigned int length) {
+    if (length == 0) {
+        if (buffer) buffer[0] = '\0';
+        len = 0;
+        return;
+    }
+    if (!grow(length)) return;
+    memmove(buffer, cstr, length);
+    buffer[length] = '\0';
+    len = length;
+}
+
+bool String::concat(const char* cstr, unsigned int length) {
+    if (!cstr) return false;
+    if (length == 0) return true;
+    if (!grow(len + length)) return false;
+    memmove(buffer + len, cstr, length);
+    len += length;
+    buffer[len] = '\0';
+    return true;
+}
+
+bool String::concat(const String& str) { return concat(str.c_str(), str.len); }
+bool String::concat(const char* cstr) { return cstr ? concat(cstr, strlen(cstr)) : false; }
+bool String::concat(char c) { return concat(&c, 1); }
+bool String::concat(int value) { return concat(String(value)); }
+bool String::concat(unsigned int value) { return concat(String(value)); }
+bool String::concat(long value) { return concat(String(value)); }
+bool String::concat(unsigned long value) { return concat(String(value)); }
+bool String::concat(const __FlashStringHelper* str) { return concat(reinterpret_cast<const char*>(str)); }
+
+String operator+(const String& lhs, const String& rhs) { String s(lhs); s.concat(rhs); return s; }
+String operator+(const String& lhs, const char* rhs) { String s(lhs); s.concat(rhs); return s; }
+String operator+(const char* lhs, const String& rhs) { String s(lhs); s.concat(rhs); return s; }
+String operator+(const String& lhs, char rhs) { String s(lhs); s.concat(rhs); return s; }
+String operator+(const String& lhs, const __FlashStringHelper* rhs) { String s(lhs); s.concat(rhs); return s; }
+
+int String::compareTo(const String& s) const {
+    return strcmp(c_str(), s.c_str());
+}
+
+bool String::equals(const String& s) const {
+    return len == s.len && compareTo(s) == 0;
+}
+
+bool String::equals(const char* cstr) const {
+    return strcmp(c_str(), cstr ? cstr : "") == 0;
+}
+
+bool String::equalsIgnoreCase(const String& s) const {
+    if (len != s.len) return false;
+    for (unsigned int i = 0; i < len; i++) {
+        if (tolower((unsigned char)buffer[i]) != tolower((unsigned char)s.buffer[i])) return false;
+    }
+    return true;
+}
+
+bool String::startsWith(const String& prefix) const {
+    return startsWith(prefix, 0);
+}
+
+bool String::startsWith(const String& prefix, unsigned int offset) const {
+    if (offset + prefix.len > len) return false;
+    return strncmp(c_str() + offset, prefix.c_str(), prefix.len) == 0;
+}
+
+bool String::endsWith(const String& suffix) const {
+    if (suffix.len > len) return false;
+    return strcmp(c_str() + len - suffix.len, suffix.c_str()) == 0;
+}
+
+char String::charAt(unsigned int index) const {
+    return operator[](index);
+}
+
+void String::setCharAt(unsigned int index, char c) {
+    if (index < len) buffer[index] = c;
+}
+
+char String::operator[](unsigned int index) const {
+    return index < len ? buffer[index] : 0;
+}
+
+char& String::operator[](unsigned int index) {
+    static char dummy;
+    if (index >= len) { dummy = 0; return dummy; }
+    return buffer[index];
+}
+
+int String::indexOf(char ch, unsigned int fromIndex) const {
+    if (fromIndex >= len) return -1;
+    const char* p = strchr(buffer + fromIndex, ch);
+    return p ? (int)(p - buffer) : -1;
+}
+
+int String::indexOf(const String& str, unsigned int fromIndex) const {
+    if (fromIndex >= len && !(fromIndex == 0 && str.len == 0)) return -1;
+    const char* p = strstr(c_str() + fromIndex, str.c_str());
+    return p ? (int)(p - c_str()) : -1;
+}
+
+int String::lastIndexOf(char ch) const {
+    if (!len) return -1;
+    const char* p = strrchr(buffer, ch);
+    return p ? (int)(p - buffer) : -1;
+}
+
+int String::lastIndexOf(const String& str) const {
+    if (str.len > len) return -1;
+    for (int i = (int)(len - str.len); i >= 0; i--) {
+        if (strncmp(buffer + i, str.c_str(), str.len) == 0) return i;
+    }
+    return -1;
+}
+
+String String::substring(unsigned int beginIndex, unsigned int endIndex) const {
+    if (beginIndex > endIndex) std::swap(beginIndex, endIndex);
+    if (beginIndex >= len) return String();
+    if (endIndex > len) endIndex = len;
+    return String(buffer + beginIndex, endIndex - beginIndex);
+}
+
+void String::replace(const String& find, const String& replaceWith) {
+    if (find.len == 0 || len == 0) return;
+    String out;
+    unsigned int i = 0;
+    while (i < len) {
+        if (strncmp(buffer + i, find.c_str(), find.len) == 0) {
+            out.concat(replaceWith);
+            i += find.len;
+        } else {
+            out.concat(buffer[i]);
+            i++;
+        }
+    }
+    *this = out;
+}
+
+void String::remove(unsigned int index) {
+    remove(index, (unsigned int)-1);
+}
+
+void String::remove(unsigned int index, unsigned int count) {
+    if (index >= len) return;
+    if (count > len - index) count = len - index;
+    memmove(buffer + index, buffer + index + count, len - index - count + 1);
+    len -= count;
+}
+
+void String::toLowerCase() {
+    for (unsigned int i = 0; i < len; i++) buffer[i] = (char)tolower((unsigned char)buffer[i]);
+}
+
+void String::toUpperCase() {
+    for (unsigned int i = 0; i < len; i++) buffer[i] = (char)toupper((unsigned char)buffer[i]);
+}
+
+void String::trim() {
+    if (!len) return;
+    unsigned int begin = 0;
+    while (begin < len && isspace((unsigned char)buffer[begin])) begin++;
+    unsigned int end = len;
+    while (end > begin && isspace((unsigned char)buffer[end - 1])) end--;
+    len = end - begin;
+    memmove(buffer, buffer + begin, len);
+    buffer[len] = '\0';
+}
+
+long String::toInt() const {
+    return len ? atol(buffer) : 0;
+}
@@ -0,0 +1,212 @@
+#include "journal.h"
+#include "telemetry.h"
+
+#define JOURNAL_PATH     "/journal.bin"
+#define JOURNAL_TMP_PATH "/journal.tmp"
+#define JOURNAL_MAGIC    0x4A53  // "SJ" little-endian
+#define JOURNAL_VERSION  1
+
+// On flash: type, length, payload, CRC-16 over all three (little-endian)
+struct JournalRecordHead {
+    uint8_t type;
+    uint8_t len;
+};
+
+struct JournalHeader {
+    uint16_t magic;
+    uint8_t version;
+};
+
+// CRC-16/CCITT-FALSE, continued from crc
+static uint16_t crc16(uint16_t crc, const uint8_t* data, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        crc ^= (uint16_t)data[i] << 8;
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+        }
+    }
+    return crc;
+}
+
+Journal journal;
+
+Journal::Journal() :
+    clientCount(0),
+    compacting(false),
+    compactFailed(false),
+    recordCount(0),
+    compactionCount(0),
+    compactAt(JOURNAL_COMPACT_BYTES)
+{
+}
+
+bool Journal::attach(JournalClient& client) {
+    if (clientCount >= JOURNAL_MAX_CLIENTS) {
+        Serial.println(F("Journal: too many clients"));
+        return false;
+    }
+    clients[clientCount++] = &client;
+    return true;
+}
+
+bool Journal::begin() {
+    TelemetryScope telemetryScope(TEL_OP_JOURNAL);
+    if (!LittleFS.begin()) {
+        Serial.println(F("ERROR: LittleFS mount failed, settings will not be kept"));
+        return false;
+    }
+
+    // A torn tail or a missing file is rewritten from what did replay
+    if (!replay()) {
+        return compact();
+    }
+
+    file = LittleFS.open(JOURNAL_PATH, "a");
+    if (!file) {
+        Serial.println(F("ERROR: Cannot open the journal"));
+        return false;
+    }
+    return true;
+}
+
+// Apply every intact record in order. False when the file is missing, has
+// a foreign header or ends in a partly written record.
+bool Journal::replay() {
+    unsigned long start = millis();
+    recordCount = 0;
+
+    File in = LittleFS.open(JOURNAL_PATH, "r");
+    if (!in) {
+        Serial.println(F("Journal: none yet"));
+        return false;
+    }
+
+    bool intact = true;
+    uint8_t payload[255];
+    JournalRecordHead head;
+    while (in.available() > 0) {
+        uint8_t crcBytes[2];
+        if (in.read((uint8_t*)&head, sizeof(head)) != sizeof(head) ||
+            in.read(payload, head.len) != head.len ||
+            in.read(crcBytes, sizeof(crcBytes)) != sizeof(crcBytes)) {
+            intact = false;
+            break;
+        }
+        uint16_t crc = crc16(crc16(0xFFFF, (const uint8_t*)&head, sizeof(head)), payload, head.len);
+        if (crc != (uint16_t)(crcBytes[0] | (crcBytes[1] << 8))) {
+            intact = false;
+            break;
+        }
+
+        if (recordCount == 0) {
+            // Anything else up front is not ours - start over
+            const JournalHeader* header = (const JournalHeader*)payload;
+            if (head.type != JOURNAL_HEADER || head.len != sizeof(JournalHeader) ||
+                header->magic != JOURNAL_MAGIC || header->version != JOURNAL_VERSION) {
+                intact = false;
+                break;
+            }
+        } else {
+            for (uint8_t i = 0; i < clientCount; i++) {
+                clients[i]->restore(head.type, payload, head.len);
+            }
+        }
+        recordCount++;
+    }
+    size_t size = in.size();
+    in.close();
+
+    Serial.print(F("Journal: "));
+    Serial.print(recordCount);
+    Serial.print(F(" records, "));
+    Serial.print(size);
+    Serial.print(F(" bytes replayed in "));
+    Serial.print(millis() - start);
+    Serial.println(F(" ms"));
+    if (!intact) {
+        Serial.println(F("Journal: damaged or unknown record, compacting"));
+    }
+    return intact;
+}
+
+bool Journal::append(uint8_t type, const void* data, uint8_t len) {
+    if (!file) {
+        return false;
+    }
+    if (!writeRecord(file, type, data, len)) {
+        Serial.println(F("ERROR: Journal write failed"));
+        compactFailed = compacting;
+        return false;
+    }
+    recordCount++;
+
+    if (compacting) {
+        return true;
+    }
+    file.flush();  // Durable from here on
+    if (file.size() >= compactAt) {
+        compact();  // The record is kept either way
+    }
+    return true;
+}
+
+bool Journal::writeRecord(File& out, uint8_t type, const void* data, uint8_t len) {
+    JournalRecordHead head = { type, len };
+    uint16_t crc = crc16(crc16(0xFFFF, (const uint8_t*)&head, sizeof(head)), (const uint8_t*)data, len);
+    uint8_t crcBytes[2] = { (uint8_t)crc, (uint8_t)(crc >> 8) };
+    return out.write((const uint8_t*)&head, sizeof(head)) == sizeof(head) &&
+           out.write((const uint8_t*)data, len) == len &&
+           out.write(crcBytes, sizeof(crcBytes)) == sizeof(crcBytes);
+}
+
+// Write the clients' state to a new file and swap it in
+bool Journal::compact() {
+    if (file) {
+        file.close();
+    }
+
+    file = LittleFS.open(JOURNAL_TMP_PATH, "w");
+    if (!file) {
+        Serial.println(F("ERROR: Cannot create the journal"));
+        return false;
+    }
+
+    // Clients write through append(), which flags any failed write; a
+    // partial snapshot must never replace the journal
+    uint16_t previousCount = recordCount;
+    compacting = true;
+    compactFailed = false;
+    recordCount = 0;
+    JournalHeader header = { JOURNAL_MAGIC, JOURNAL_VERSION };
+    append(JOURNAL_HEADER, &header, sizeof(header));
+    for (uint8_t i = 0; !compactFailed && i < clientCount; i++) {
+        clients[i]->snapshot(*this);
+    }
+    bool ok = !compactFailed;
+    compacting = false;
+    file.close();
+
+    ok = ok && LittleFS.rename(JOURNAL_TMP_PATH, JOURNAL_PATH);
+    if (!ok) {
+        Serial.println(F("ERROR: Journal compaction failed"));
+        LittleFS.remove(JOURNAL_TMP_PATH);
+        recordCount = previousCount;
+    } else {
+        compactionCount++;
+    }
+
+    file = LittleFS.open(JOURNAL_PATH, "a");
+    if (!file) {
+        Serial.println(F("ERROR: Cannot open the journal"));
+        return false;
+    }
+
+    // The old journal is still over the threshold; retrying on every
+    // append would rewrite the new file each time, so wait until it has
+    // grown by another JOURNAL_COMPACT_BYTES
+    compactAt = ok ? JOURNAL_COMPACT_BYTES : file.size() + JOURNAL_COMPACT_BYTES;
+    Serial.print(ok ? F("Journal: compacted to ") : F("Journal: kept at "));
+    Serial.print(file.size());
+    Serial.println(F(" bytes"));
+    return ok;
+}
@@ -0,0 +1,71 @@
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include <Arduino.h>
+#include <LittleFS.h>
+#include "config.h"
+
+// Record types; each one belongs to a single JournalClient
+enum JournalRecordType : uint8_t {
+    JOURNAL_HEADER = 1,     // First record of every journal file
+    JOURNAL_NET_ADD,        // SavedNetworks
+    JOURNAL_NET_REMOVE,
+    JOURNAL_NET_CLEAR,
+    JOURNAL_FILTERS,        // WifiMenu
+    JOURNAL_SCAN_PREFS,
+    JOURNAL_DISPLAY,        // PowerManager
+    JOURNAL_BUZZER,         // Feedback
+    JOURNAL_DEAUTH_RATE     // DeauthDetector
+};
+
+class Journal;
+
+// Something whose state is kept in the journal. restore() applies one
+// record during replay, snapshot() appends records that rebuild the
+// current state from nothing when the journal is compacted.
+class JournalClient {
+public:
+    virtual ~JournalClient() {}
+
+    virtual void restore(uint8_t type, const uint8_t* data, uint8_t len) = 0;
+    virtual void snapshot(Journal& journal) = 0;
+};
+
+// Append-only settings journal on LittleFS. Every change is one small
+// record (type, length, payload, CRC-16) added to the end of the file and
+// flushed; nothing is rewritten in place. At boot the file is replayed in
+// order and later records win. Once it grows past JOURNAL_COMPACT_BYTES
+// the clients' current state is written to a new file, which then
+// replaces the old one with a single rename - a power cut at any point
+// leaves either the old journal or the new one. After a failed compaction
+// the next one waits for another JOURNAL_COMPACT_BYTES of records.
+class Journal {
+public:
+    Journal();
+
+    bool attach(JournalClient& client);   // Before begin()
+    bool begin();                         // Mount and replay
+
+    bool append(uint8_t type, const void* data, uint8_t len);
+
+    uint16_t getRecordCount() const { return recordCount; }
+    uint16_t getCompactionCount() const { return compactionCount; }
+
+private:
+    bool replay();
+    bool compact();
+    bool writeRecord(File& out, uint8_t type, const void* data, uint8_t len);
+
+    JournalClient* clients[JOURNAL_MAX_CLIENTS];
+    uint8_t clientCount;
+    File file;                // Open for appending once begin() succeeds
+    bool compacting;          // Records go to the new file
+    bool compactFailed;       // A write to the new file failed
+    uint16_t recordCount;     // In the current file
+    uint16_t compactionCount;
+    size_t compactAt;         // File size that starts the next compaction
+};
+
+extern Journal journal;
+
+#endif
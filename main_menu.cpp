@@ -1,16 +1,13 @@
 #include "main_menu.h"
 #include "config.h"
 #include "wifi.h"
-#include <EEPROM.h>
+#include "telemetry.h"
+#include "frame_ring.h"
+#include "feedback.h"
 
 // OLED Display Object
-Adafruit_SSD1306 display(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, OLED_RESET);
+ShadowedSSD1306 display(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, OLED_RESET);
 
-// Global instances
-WifiMenu wifi;
-ButtonManager buttonManager; // Renamed for consistency with class name
-
-extern void debugEEPROM();
 // Last time an animation frame was updated
 unsigned long lastAnimationTime = 0;
 const unsigned long ANIMATION_DELAY = 5; // ms between animation frames
@@ -54,10 +51,11 @@ void MainMenu::begin() {
 // ==========================
 // Clear Display
 // ==========================
+// Buffer only - the caller draws and pushes the finished frame, so the
+// panel never gets a blank one in between
 void MainMenu::clear() {
     display.clearDisplay();
     display.setCursor(0, 0);
-    display.display();
 }
 
 // ==========================
@@ -164,473 +162,467 @@ void MainMenu::showMessage(const String& message) {
 // Show Saved Networks
 //=============================
 void MainMenu::showSavedNetworks() {
-    int networkCount = wifi.getSavedNetworkCount();
-    int selectedIndex = 0;
-    bool exitMenu = false;
-    unsigned long lastButtonCheckTime = 0;
-    const unsigned long BUTTON_CHECK_INTERVAL = 100; // ms between button checks
-    
-    // Cache for network data to avoid repeated EEPROM reads
-    struct NetworkCache {
-        String ssid;
-        String bssid;
-        bool valid;
-    };
-    NetworkCache* networkCache = new NetworkCache[MAX_NETWORKS];
-    
-    // Initialize cache as invalid
-    for (int i = 0; i < MAX_NETWORKS; i++) {
-        networkCache[i].valid = false;
-    }
+    screens.push(&savedList);
+}
+
+// Saved networks have no SSID text when they were hidden
+static const char* savedName(const SavedNetwork& net) {
+    return net.isHidden() ? "[Hidden]" : net.ssid;
+}
+
+void MainMenu::SavedListScreen::onEnter() {
+    telemetry.enter(TEL_OP_SAVED_LIST);
+    selectedIndex = 0;
     
     Serial.print(F("showSavedNetworks: Found "));
-    Serial.print(networkCount);
+    Serial.print(savedNetworks.count());
     Serial.println(F(" networks"));
+}
+
+void MainMenu::SavedListScreen::onExit() {
+    telemetry.exit(TEL_OP_SAVED_LIST);
+}
+
+void MainMenu::SavedListScreen::update(Button btn) {
+    if (btn != NONE) invalidate();
+    int networkCount = savedNetworks.count();
     
-    while (!exitMenu) {
-        display.clearDisplay();
+    if (btn == UP) {
+        if (networkCount > 0) {
+            selectedIndex = (selectedIndex > 0) ? selectedIndex - 1 : networkCount - 1;
+        }
+    } 
+    else if (btn == DOWN) {
+        if (networkCount > 0) {
+            selectedIndex = (selectedIndex < networkCount - 1) ? selectedIndex + 1 : 0;
+        }
+    }
+    else if (btn == SELECT) {
+        if (networkCount > 0) {
+            // Show options menu; its result is handled in onResume()
+            options.open(savedNetworks.get(selectedIndex));
+        }
+    }
+    else if (btn == BACK) {
+        screens.pop();
+    }
+}
+
+// One of the dialogs closed - act on what was picked
+void MainMenu::SavedListScreen::onResume(Screen* closed) {
+    if (closed == &options) {
+        int optionResult = options.getChoice();
         
-        // Title bar
-        display.fillRect(0, 0, 128, 12, SSD1306_WHITE);
-        display.setTextColor(SSD1306_BLACK);
-        display.setTextSize(1);
-        display.setCursor(16, 2);
-        display.print("SAVED NETWORKS");
+        if (optionResult == 1) { // View Details
+            details.open(savedNetworks.get(selectedIndex));
+        } 
+        else if (optionResult == 2) { // Delete Network
+            confirm.open(savedNetworks.get(selectedIndex));
+        } 
+        else if (optionResult == 3) { // Use for Deauth
+            // Flag this network for deauth
+            // (You might need to implement this storage mechanism)
+            
+            // Exit to the main menu, with a confirmation on the way
+            screens.pop();
+            messageScreen.open(F("Network selected\nfor deauth attack"), 1500, 10, 24);
+            feedback.play(FEEDBACK_SUCCESS);
+        }
+        // Option 0 (Cancel) just returns to the network list
+    }
+    else if (closed == &confirm && confirm.isConfirmed()) {
+        savedNetworks.remove(selectedIndex);
         
-        // Content area
-        display.setTextColor(SSD1306_WHITE);
+        // Adjust selected index if needed
+        if (selectedIndex >= savedNetworks.count()) {
+            selectedIndex = max(0, savedNetworks.count() - 1);
+        }
         
-        if (networkCount == 0) {
-            // No saved networks
-            display.setCursor(10, 24);
-            display.print("No networks saved");
-            display.setCursor(15, 36);
-            display.print("Scan and save");
-            display.setCursor(8, 48);
-            display.print("networks first");
+        // Show confirmation
+        messageScreen.open(F("Network deleted"), 1500, 10, 24);
+        feedback.play(FEEDBACK_SUCCESS);
+    }
+}
+
+void MainMenu::SavedListScreen::render() {
+    // Title bar
+    display.fillRect(0, 0, 128, 12, SSD1306_WHITE);
+    display.setTextColor(SSD1306_BLACK);
+    display.setTextSize(1);
+    display.setCursor(16, 2);
+    display.print("SAVED NETWORKS");
+    
+    // Content area
+    display.setTextColor(SSD1306_WHITE);
+    int networkCount = savedNetworks.count();
+    
+    if (networkCount == 0) {
+        // No saved networks
+        display.setCursor(10, 24);
+        display.print("No networks saved");
+        display.setCursor(15, 36);
+        display.print("Scan and save");
+        display.setCursor(8, 48);
+        display.print("networks first");
+        return;
+    }
+
+    // Show how many networks we have
+    display.setCursor(0, 14);
+    display.print("Networks: ");
+    display.print(networkCount);
+    display.print("/");
+    display.print(MAX_NETWORKS);
+    
+    // Calculate visible networks (up to 3 at once)
+    int startIdx = max(0, min(selectedIndex - 1, networkCount - 3));
+    int endIdx = min(startIdx + 3, networkCount);
+    
+    // Draw list of networks
+    for (int i = 0; i < (endIdx - startIdx); i++) {
+        int networkIdx = startIdx + i;
+        int y = 26 + i * 12;
+        
+        // Highlight selected network
+        if (networkIdx == selectedIndex) {
+            display.fillRect(0, y, 128, 12, SSD1306_WHITE);
+            display.setTextColor(SSD1306_BLACK);
         } else {
-            // Show how many networks we have
-            display.setCursor(0, 14);
-            display.print("Networks: ");
-            display.print(networkCount);
-            display.print("/");
-            display.print(MAX_NETWORKS);
-            
-            // Calculate visible networks (up to 3 at once)
-            int startIdx = max(0, min(selectedIndex - 1, networkCount - 3));
-            int endIdx = min(startIdx + 3, networkCount);
-            
-            // Draw list of networks
-            for (int i = 0; i < (endIdx - startIdx); i++) {
-                int networkIdx = startIdx + i;
-                int y = 26 + i * 12;
-                
-                // Check if we need to load this network into cache
-                if (!networkCache[networkIdx].valid) {
-                    String ssid, bssid;
-                    bool success = wifi.getSavedNetwork(networkIdx, ssid, bssid);
-                    
-                    if (success) {
-                        networkCache[networkIdx].ssid = ssid;
-                        networkCache[networkIdx].bssid = bssid;
-                        networkCache[networkIdx].valid = true;
-                    }
-                }
-                
-                // Highlight selected network
-                if (networkIdx == selectedIndex) {
-                    display.fillRect(0, y, 128, 12, SSD1306_WHITE);
-                    display.setTextColor(SSD1306_BLACK);
-                } else {
-                    display.setTextColor(SSD1306_WHITE);
-                }
-                
-                if (networkCache[networkIdx].valid) {
-                    String ssid = networkCache[networkIdx].ssid;
-                    
-                    // Extract SSID from saved network (if it contains signal strength info)
-                    int bracketPos = ssid.lastIndexOf("(");
-                    if (bracketPos > 0) {
-                        ssid = ssid.substring(0, bracketPos);
-                        ssid.trim();
-                    }
-                    
-                    // Truncate if too long
-                    if (ssid.length() > 18) {
-                        ssid = ssid.substring(0, 15) + "...";
-                    }
-                    
-                    // Display SSID
-                    display.setCursor(2, y + 2);
-                    display.print(ssid);
-                } else {
-                    // Error reading network
-                    display.setCursor(2, y + 2);
-                    display.print("[Read Error]");
-                }
-            }
-            
-            // Scroll indicators
-            if (startIdx > 0) {
-                display.setTextColor(SSD1306_WHITE);
-                display.setCursor(120, 15);
-                display.print("^");
-            }
-            if (endIdx < networkCount) {
-                display.setTextColor(SSD1306_WHITE);
-                display.setCursor(120, 56);
-                display.print("v");
-            }
-            
-            // Footer with instructions
             display.setTextColor(SSD1306_WHITE);
-            display.setCursor(0, 56);
-            display.print("SEL:Options  BACK:Exit");
         }
         
-        display.display();
+        display.setCursor(2, y + 2);
+        const char* ssid = savedName(savedNetworks.get(networkIdx));
         
-        // Non-blocking button handling with rate limiting
-        unsigned long currentTime = millis();
-        if (currentTime - lastButtonCheckTime >= BUTTON_CHECK_INTERVAL) {
-            lastButtonCheckTime = currentTime;
-            
-            // Handle button input
-            Button btn = buttonManager.readButton();
-            
-            if (btn == UP) {
-                if (networkCount > 0) {
-                    selectedIndex = (selectedIndex > 0) ? selectedIndex - 1 : networkCount - 1;
-                }
-            } 
-            else if (btn == DOWN) {
-                if (networkCount > 0) {
-                    selectedIndex = (selectedIndex < networkCount - 1) ? selectedIndex + 1 : 0;
-                }
-            }
-            else if (btn == SELECT) {
-                if (networkCount > 0 && networkCache[selectedIndex].valid) {
-                    String ssid = networkCache[selectedIndex].ssid;
-                    String bssid = networkCache[selectedIndex].bssid;
-                    
-                    // Extract clean SSID from saved network
-                    String displaySSID = ssid;
-                    int bracketPos = ssid.lastIndexOf("(");
-                    if (bracketPos > 0) {
-                        displaySSID = ssid.substring(0, bracketPos);
-                        displaySSID.trim();
-                    }
-                    
-                    // Show options menu and handle the result
-                    int optionResult = showNetworkOptionsMenu(displaySSID);
-                    
-                    if (optionResult == 1) { // View Details
-                        showNetworkDetails(ssid, bssid);
-                    } 
-                    else if (optionResult == 2) { // Delete Network
-                        if (confirmDelete(displaySSID)) {
-                            wifi.deleteSavedNetwork(selectedIndex);
-                            networkCount = wifi.getSavedNetworkCount();
-                            
-                            // Invalidate all cache entries
-                            for (int i = 0; i < MAX_NETWORKS; i++) {
-                                networkCache[i].valid = false;
-                            }
-                            
-                            // Adjust selected index if needed
-                            if (selectedIndex >= networkCount) {
-                                selectedIndex = max(0, networkCount - 1);
-                            }
-                            
-                            // Show confirmation
-                            display.clearDisplay();
-                            display.setTextColor(SSD1306_WHITE);
-                            display.setCursor(10, 24);
-                            display.print("Network deleted");
-                            display.display();
-                            
-                            // Non-blocking delay
-                            unsigned long deleteConfirmStart = millis();
-                            while (millis() - deleteConfirmStart < 1500) yield();
-                        }
-                    } 
-                    else if (optionResult == 3) { // Use for Deauth
-                        // Select this network for deauth attack
-                        display.clearDisplay();
-                        display.setTextColor(SSD1306_WHITE);
-                        display.setCursor(10, 24);
-                        display.print("Network selected");
-                        display.setCursor(10, 34);
-                        display.print("for deauth attack");
-                        display.display();
-                        
-                        // Non-blocking delay
-                        unsigned long confirmStart = millis();
-                        while (millis() - confirmStart < 1500) yield();
-                        
-                        // Flag this network for deauth
-                        // (You might need to implement this storage mechanism)
-                        
-                        // Exit to the main menu
-                        exitMenu = true;
-                    }
-                    // Option 0 or 4 (Cancel) just returns to the network list
-                }
-            }
-            else if (btn == BACK) {
-                exitMenu = true;
-            }
+        // Truncate if too long
+        if (strlen(ssid) > 18) {
+            display.write(ssid, 15);
+            display.print("...");
+        } else {
+            display.print(ssid);
         }
-        
-        yield(); // Allow background processes to run
     }
     
-    // Clean up
-    delete[] networkCache;
+    // Scroll indicators
+    if (startIdx > 0) {
+        display.setTextColor(SSD1306_WHITE);
+        display.setCursor(120, 15);
+        display.print("^");
+    }
+    if (endIdx < networkCount) {
+        display.setTextColor(SSD1306_WHITE);
+        display.setCursor(120, 56);
+        display.print("v");
+    }
+    
+    // Footer with instructions
+    display.setTextColor(SSD1306_WHITE);
+    display.setCursor(0, 56);
+    display.print("SEL:Options  BACK:Exit");
 }
 
 // Network options menu implementation - works with 4 buttons (UP, DOWN, SELECT, BACK)
-int MainMenu::showNetworkOptionsMenu(const String& ssid) {
-    const int optionCount = 4; // Number of options
-    const char* options[optionCount] = {
-        "View Details",
-        "Delete Network",
-        "Use for Deauth",
-        "Cancel"
-    };
-    
-    int selectedOption = 0;
-    bool menuActive = true;
-    unsigned long lastButtonCheckTime = 0;
-    const unsigned long BUTTON_CHECK_INTERVAL = 100;
+static const int NETWORK_OPTION_COUNT = 4;
+static const char* const NETWORK_OPTIONS[NETWORK_OPTION_COUNT] = {
+    "View Details",
+    "Delete Network",
+    "Use for Deauth",
+    "Cancel"
+};
+
+void MainMenu::OptionsScreen::open(const SavedNetwork& saved) {
+    network = &saved;
+    screens.push(this);
+}
+
+void MainMenu::OptionsScreen::onEnter() {
+    selectedOption = 0;
+    choice = 0;  // Default: no action
+}
+
+void MainMenu::OptionsScreen::update(Button btn) {
+    if (btn != NONE) invalidate();
     
-    while (menuActive) {
-        display.clearDisplay();
-        
-        // Title bar
-        display.fillRect(0, 0, SCREEN_WIDTH, 12, SSD1306_WHITE);
-        display.setTextColor(SSD1306_BLACK);
-        display.setCursor(20, 2);
-        display.print(F("NETWORK OPTIONS"));
-        
-        // Network name
-        display.setTextColor(SSD1306_WHITE);
-        display.setCursor(0, 14);
-        // Truncate SSID if too long
-        String displayName = ssid;
-        if (displayName.length() > 21) {
-            displayName = displayName.substring(0, 18) + "...";
-        }
-        display.print(displayName);
-        
-        // Draw options
-        for (int i = 0; i < optionCount; i++) {
-            int y = 26 + (i * 10);
+    switch (btn) {
+        case UP:
+            selectedOption = (selectedOption > 0) ? selectedOption - 1 : NETWORK_OPTION_COUNT - 1;
+            break;
+            
+        case DOWN:
+            selectedOption = (selectedOption < NETWORK_OPTION_COUNT - 1) ? selectedOption + 1 : 0;
+            break;
             
-            // Highlight selected option
-            if (i == selectedOption) {
-                display.fillRect(0, y - 1, SCREEN_WIDTH, 10, SSD1306_WHITE);
-                display.setTextColor(SSD1306_BLACK);
+        case SELECT:
+            if (selectedOption == NETWORK_OPTION_COUNT - 1) { // Cancel
+                choice = 0; // No action
             } else {
-                display.setTextColor(SSD1306_WHITE);
+                choice = selectedOption + 1; // Option index (1-based)
             }
+            screens.pop();
+            break;
             
-            display.setCursor(2, y);
-            display.print(options[i]);
-        }
-        
-        display.display();
-        
-        // Handle button input
-        unsigned long currentTime = millis();
-        if (currentTime - lastButtonCheckTime >= BUTTON_CHECK_INTERVAL) {
-            lastButtonCheckTime = currentTime;
-            
-            Button btn = buttonManager.readButton();
+        case BACK:
+            choice = 0; // No action, same as Cancel
+            screens.pop();
+            break;
             
-            switch (btn) {
-                case UP:
-                    selectedOption = (selectedOption > 0) ? selectedOption - 1 : optionCount - 1;
-                    break;
-                    
-                case DOWN:
-                    selectedOption = (selectedOption < optionCount - 1) ? selectedOption + 1 : 0;
-                    break;
-                    
-                case SELECT:
-                    if (selectedOption == optionCount - 1) { // Cancel
-                        menuActive = false;
-                        return 0; // No action
-                    } else {
-                        menuActive = false;
-                        return selectedOption + 1; // Return option index (1-based)
-                    }
-                    break;
-                    
-                case BACK:
-                    menuActive = false;
-                    return 0; // No action, same as Cancel
-                    
-                default:
-                    break;
-            }
+        default:
+            break;
+    }
+}
+
+void MainMenu::OptionsScreen::render() {
+    // Title bar
+    display.fillRect(0, 0, SCREEN_WIDTH, 12, SSD1306_WHITE);
+    display.setTextColor(SSD1306_BLACK);
+    display.setCursor(20, 2);
+    display.print(F("NETWORK OPTIONS"));
+    
+    // Network name
+    display.setTextColor(SSD1306_WHITE);
+    display.setCursor(0, 14);
+    // Truncate SSID if too long
+    const char* ssid = savedName(*network);
+    if (strlen(ssid) > 21) {
+        display.write(ssid, 18);
+        display.print(F("..."));
+    } else {
+        display.print(ssid);
+    }
+    
+    // Draw options
+    for (int i = 0; i < NETWORK_OPTION_COUNT; i++) {
+        int y = 26 + (i * 10);
+        
+        // Highlight selected option
+        if (i == selectedOption) {
+            display.fillRect(0, y - 1, SCREEN_WIDTH, 10, SSD1306_WHITE);
+            display.setTextColor(SSD1306_BLACK);
+        } else {
+            display.setTextColor(SSD1306_WHITE);
         }
         
-        yield(); // Allow background processes to run
+        display.setCursor(2, y);
+        display.print(NETWORK_OPTIONS[i]);
     }
-    
-    return 0; // Default: no action
 }
 
+// Confirmation dialog for network deletion - works with 4 buttons
+void MainMenu::ConfirmDeleteScreen::open(const SavedNetwork& saved) {
+    network = &saved;
+    screens.push(this);
+}
 
+void MainMenu::ConfirmDeleteScreen::onEnter() {
+    confirmed = false; // Start with NO selected
+    result = false;
+}
 
-// Confirmation dialog for network deletion - works with 4 buttons
-bool MainMenu::confirmDelete(const String& ssid) {
-    bool confirmed = false; // Start with NO selected
-    bool dialogActive = true;
-    unsigned long lastButtonCheckTime = 0;
-    const unsigned long BUTTON_CHECK_INTERVAL = 100;
+void MainMenu::ConfirmDeleteScreen::update(Button btn) {
+    if (btn != NONE) invalidate();
     
-    while (dialogActive) {
-        display.clearDisplay();
-        
-        // Title
-        display.setTextColor(SSD1306_WHITE);
-        display.setCursor(10, 8);
-        display.print(F("Confirm Delete:"));
-        
-        // Network name
-        display.setCursor(5, 22);
-        // Truncate SSID if too long
-        String displayName = ssid;
-        if (displayName.length() > 20) {
-            displayName = displayName.substring(0, 17) + "...";
-        }
-        display.print(displayName);
-        
-        // Options - highlight the selected option
-        display.fillRect(5, 35, 50, 14, confirmed ? SSD1306_WHITE : SSD1306_BLACK);
-        display.fillRect(73, 35, 50, 14, confirmed ? SSD1306_BLACK : SSD1306_WHITE);
-        
-        display.setTextColor(confirmed ? SSD1306_BLACK : SSD1306_WHITE);
-        display.setCursor(19, 39);
-        display.print(F("YES"));
-        
-        display.setTextColor(confirmed ? SSD1306_WHITE : SSD1306_BLACK);
-        display.setCursor(87, 39);
-        display.print(F("NO"));
-        
-        // Instructions for 4-button navigation
-        display.setTextColor(SSD1306_WHITE);
-        display.setCursor(2, 55);
-        display.print(F("UP/DN:Toggle SEL:Confirm"));
-        
-        display.display();
-        
-        // Handle button input
-        unsigned long currentTime = millis();
-        if (currentTime - lastButtonCheckTime >= BUTTON_CHECK_INTERVAL) {
-            lastButtonCheckTime = currentTime;
+    switch (btn) {
+        case UP:
+        case DOWN:
+            confirmed = !confirmed; // Toggle between YES/NO with UP or DOWN
+            break;
             
-            Button btn = buttonManager.readButton();
+        case SELECT:
+            result = confirmed; // YES/NO selection
+            screens.pop();
+            break;
             
-            switch (btn) {
-                case UP:
-                case DOWN:
-                    confirmed = !confirmed; // Toggle between YES/NO with UP or DOWN
-                    break;
-                    
-                case SELECT:
-                    dialogActive = false;
-                    return confirmed; // Return YES/NO selection
-                    
-                case BACK:
-                    dialogActive = false;
-                    return false; // Cancel = NO
-                    
-                default:
-                    break;
-            }
-        }
-        
-        yield(); // Allow background processes to run
+        case BACK:
+            result = false; // Cancel = NO
+            screens.pop();
+            break;
+            
+        default:
+            break;
+    }
+}
+
+void MainMenu::ConfirmDeleteScreen::render() {
+    // Title
+    display.setTextColor(SSD1306_WHITE);
+    display.setCursor(10, 8);
+    display.print(F("Confirm Delete:"));
+    
+    // Network name
+    display.setCursor(5, 22);
+    // Truncate SSID if too long
+    const char* ssid = savedName(*network);
+    if (strlen(ssid) > 20) {
+        display.write(ssid, 17);
+        display.print(F("..."));
+    } else {
+        display.print(ssid);
     }
     
-    return false; // Default: No
+    // Options - highlight the selected option
+    display.fillRect(5, 35, 50, 14, confirmed ? SSD1306_WHITE : SSD1306_BLACK);
+    display.fillRect(73, 35, 50, 14, confirmed ? SSD1306_BLACK : SSD1306_WHITE);
+    
+    display.setTextColor(confirmed ? SSD1306_BLACK : SSD1306_WHITE);
+    display.setCursor(19, 39);
+    display.print(F("YES"));
+    
+    display.setTextColor(confirmed ? SSD1306_WHITE : SSD1306_BLACK);
+    display.setCursor(87, 39);
+    display.print(F("NO"));
+    
+    // Instructions for 4-button navigation
+    display.setTextColor(SSD1306_WHITE);
+    display.setCursor(2, 55);
+    display.print(F("UP/DN:Toggle SEL:Confirm"));
 }
 
 // Network details viewer - works with 4 buttons
-void MainMenu::showNetworkDetails(const String& ssid, const String& bssid) {
-    bool viewActive = true;
-    unsigned long lastButtonCheckTime = 0;
-    const unsigned long BUTTON_CHECK_INTERVAL = 100;
-    
-    // Extract clean SSID
-    String displaySSID = ssid;
-    int bracketPos = ssid.lastIndexOf("(");
-    if (bracketPos > 0) {
-        displaySSID = ssid.substring(0, bracketPos);
-        displaySSID.trim();
+void MainMenu::SavedDetailsScreen::open(const SavedNetwork& saved) {
+    network = &saved;
+    screens.push(this);
+}
+
+// Only respond to BACK button
+void MainMenu::SavedDetailsScreen::update(Button btn) {
+    if (btn == BACK) {
+        screens.pop();
     }
+}
+
+void MainMenu::SavedDetailsScreen::render() {
+    // Title bar
+    display.fillRect(0, 0, SCREEN_WIDTH, 12, SSD1306_WHITE);
+    display.setTextColor(SSD1306_BLACK);
+    display.setCursor(12, 2);
+    display.print(F("NETWORK DETAILS"));
     
-    while (viewActive) {
-        display.clearDisplay();
-        
-        // Title bar
-        display.fillRect(0, 0, SCREEN_WIDTH, 12, SSD1306_WHITE);
-        display.setTextColor(SSD1306_BLACK);
-        display.setCursor(12, 2);
-        display.print(F("NETWORK DETAILS"));
-        
-        // Network details
-        display.setTextColor(SSD1306_WHITE);
-        
-        // SSID
-        display.setCursor(0, 16);
-        display.print(F("SSID:"));
-        
-        // Show SSID, handling long names
-        if (displaySSID.length() > 16) {
-            // Show scrolling text or truncated name
-            display.setCursor(0, 26);
-            display.print(displaySSID.substring(0, 20));
-            if (displaySSID.length() > 20) {
-                display.print("...");
-            }
-        } else {
-            display.setCursor(40, 16);
-            display.print(displaySSID);
+    // Network details
+    display.setTextColor(SSD1306_WHITE);
+    
+    // SSID
+    display.setCursor(0, 16);
+    display.print(F("SSID:"));
+    
+    // Show SSID, handling long names
+    const char* ssid = savedName(*network);
+    int ssidLen = strlen(ssid);
+    if (ssidLen > 16) {
+        // Show truncated name
+        display.setCursor(0, 26);
+        display.write(ssid, min(20, ssidLen));
+        if (ssidLen > 20) {
+            display.print("...");
         }
-        
-        // BSSID
-        display.setCursor(0, 36);
-        display.print(F("BSSID:"));
-        display.setCursor(40, 36);
-        display.print(bssid);
-        
-        // Status
-        display.setCursor(0, 46);
-        display.print(F("Status: Saved for deauth"));
-        
-        // Footer
-        display.setTextColor(SSD1306_WHITE);
-        display.setCursor(12, 56);
-        display.print(F("Press BACK to return"));
-        
-        display.display();
-        
-        // Handle button input - only respond to BACK button
-        unsigned long currentTime = millis();
-        if (currentTime - lastButtonCheckTime >= BUTTON_CHECK_INTERVAL) {
-            lastButtonCheckTime = currentTime;
-            
-            Button btn = buttonManager.readButton();
-            if (btn == BACK) {
-                viewActive = false;
+    } else {
+        display.setCursor(40, 16);
+        display.print(ssid);
+    }
+    
+    // BSSID
+    display.setCursor(0, 36);
+    display.print(F("BSSID:"));
+    display.setCursor(40, 36);
+    char bssid[18];
+    formatBssid(network->bssid, bssid);
+    display.print(bssid);
+    
+    // Channel and status
+    display.setCursor(0, 46);
+    display.print(F("CH: "));
+    display.print(network->channel);
+    display.print(F("  Status: Saved"));
+    
+    // Footer
+    display.setTextColor(SSD1306_WHITE);
+    display.setCursor(12, 56);
+    display.print(F("Press BACK to return"));
+}
+
+// Heap/stack diagnostics - live readings, low-water marks, the monitor's
+// frame ring, then one row per instrumented operation. UP/DOWN scroll,
+// BACK returns.
+static const int DIAG_VISIBLE_ROWS = 5;
+static const int DIAG_FIXED_ROWS = 7;
+static const int DIAG_ROW_COUNT = DIAG_FIXED_ROWS + TEL_OP_COUNT;
+static const unsigned long DIAG_SAMPLE_INTERVAL = 500;
+
+void MainMenu::showDiagnostics() {
+    screens.push(&diagnostics);
+}
+
+void MainMenu::DiagnosticsScreen::onEnter() {
+    topRow = 0;
+    lastSampleTime = millis();
+    now = telemetry.sample();
+}
+
+void MainMenu::DiagnosticsScreen::update(Button btn) {
+    unsigned long currentTime = millis();
+    if (currentTime - lastSampleTime >= DIAG_SAMPLE_INTERVAL) {
+        lastSampleTime = currentTime;
+        now = telemetry.sample();
+        invalidate();
+    }
+
+    if (btn != NONE) invalidate();
+    if (btn == UP && topRow > 0) {
+        topRow--;
+    } else if (btn == DOWN && topRow + DIAG_VISIBLE_ROWS < DIAG_ROW_COUNT) {
+        topRow++;
+    } else if (btn == BACK) {
+        screens.pop();
+    }
+}
+
+void MainMenu::DiagnosticsScreen::render() {
+    const HeapSample& low = telemetry.getLowWater();
+
+    // Title bar
+    display.fillRect(0, 0, SCREEN_WIDTH, 12, SSD1306_WHITE);
+    display.setTextColor(SSD1306_BLACK);
+    display.setCursor((SCREEN_WIDTH - 66) / 2, 2);
+    display.print(F("Diagnostics"));
+
+    display.setTextColor(SSD1306_WHITE);
+    for (int i = 0; i < DIAG_VISIBLE_ROWS && topRow + i < DIAG_ROW_COUNT; i++) {
+        int row = topRow + i;
+        char line[40];
+
+        switch (row) {
+            case 0: snprintf(line, sizeof(line), "Heap %5lu low %5lu", (unsigned long)now.freeHeap, (unsigned long)low.freeHeap); break;
+            case 1: snprintf(line, sizeof(line), "Blk  %5lu low %5lu", (unsigned long)now.maxBlock, (unsigned long)low.maxBlock); break;
+            case 2: snprintf(line, sizeof(line), "Frag %5u%% max %4u%%", now.fragmentation, low.fragmentation); break;
+            case 3: snprintf(line, sizeof(line), "Stack %5lu low %5lu", (unsigned long)now.freeStack, (unsigned long)low.freeStack); break;
+            case 4: snprintf(line, sizeof(line), "Rx %7lu drop %5lu", (unsigned long)frameRing.getPushed(), (unsigned long)frameRing.getDropped()); break;
+            case 5: snprintf(line, sizeof(line), "Ring %3u/%-3u hi %3u", frameRing.size(), frameRing.capacity(), frameRing.getHighWater()); break;
+            case 6: snprintf(line, sizeof(line), "%-10s%4s %6s", "Op", "n", "loss"); break;
+            default: {
+                const TelemetryOpStats& stats = telemetry.getOpStats(row - DIAG_FIXED_ROWS);
+                char name[12];
+                strncpy_P(name, (PGM_P)Telemetry::opName(row - DIAG_FIXED_ROWS), sizeof(name));
+                name[sizeof(name) - 1] = '\0';
+                if (stats.calls == 0) {
+                    snprintf(line, sizeof(line), "%-10s%4s", name, "-");
+                } else {
+                    snprintf(line, sizeof(line), "%-10s%4lu %6ld", name, (unsigned long)stats.calls, (long)stats.worstLoss);
+                }
+                break;
             }
         }
-        
-        yield(); // Allow background processes to run
+
+        display.setCursor(0, 16 + i * 9);
+        display.print(line);
+    }
+
+    // Scroll indicators
+    if (topRow > 0) {
+        display.setCursor(SCREEN_WIDTH - 6, 13);
+        display.print(F("^"));
+    }
+    if (topRow + DIAG_VISIBLE_ROWS < DIAG_ROW_COUNT) {
+        display.setCursor(SCREEN_WIDTH - 6, SCREEN_HEIGHT - 8);
+        display.print(F("v"));
     }
 }
 
@@ -3,8 +3,12 @@
 
 #include <Arduino.h>
 #include <Adafruit_SSD1306.h>
+#include "shadow_display.h"
 #include "config.h"
 #include "ButtonManager.h"
+#include "screen.h"
+#include "telemetry.h"
+#include "saved_networks.h"
 #include <Wire.h>
 
 #define MAX_NETWORKS 5 
@@ -20,14 +24,86 @@ public:
     void fadeTransition();
     void renderBoxMenu(const char* title, const char* options[], int count, int selectedIndex, bool useTransition);
     void showLoadingBar(int percentage);
+
+    // Screens - each call pushes onto the screen stack and returns at once
     void showSavedNetworks();
-    int showNetworkOptionsMenu(const String& ssid);
-    bool confirmDelete(const String& ssid);
-    void showNetworkDetails(const String& ssid, const String& bssid);
+    void showDiagnostics();
+
+private:
+    // What to do with one saved network; read getChoice() once it closes
+    class OptionsScreen : public Screen {
+    public:
+        void open(const SavedNetwork& network);
+        int getChoice() const { return choice; }  // 0 cancel, 1 details, 2 delete, 3 deauth
+        void update(Button btn) override;
+        void render() override;
+        void onEnter() override;
+
+    private:
+        const SavedNetwork* network;
+        int selectedOption;
+        int choice;
+    };
+
+    class ConfirmDeleteScreen : public Screen {
+    public:
+        void open(const SavedNetwork& network);
+        bool isConfirmed() const { return result; }
+        void update(Button btn) override;
+        void render() override;
+        void onEnter() override;
+
+    private:
+        const SavedNetwork* network;
+        bool confirmed;   // YES highlighted
+        bool result;
+    };
+
+    class SavedDetailsScreen : public Screen {
+    public:
+        void open(const SavedNetwork& network);
+        void update(Button btn) override;
+        void render() override;
+
+    private:
+        const SavedNetwork* network;
+    };
+
+    // Networks saved for deauth, with the dialogs it opens on top of itself
+    class SavedListScreen : public Screen {
+    public:
+        void update(Button btn) override;
+        void render() override;
+        void onEnter() override;
+        void onExit() override;
+        void onResume(Screen* closed) override;
+
+    private:
+        int selectedIndex;
+        OptionsScreen options;
+        ConfirmDeleteScreen confirm;
+        SavedDetailsScreen details;
+    };
+
+    // Heap/stack diagnostics - live readings, low-water marks, then one row
+    // per instrumented operation
+    class DiagnosticsScreen : public Screen {
+    public:
+        void update(Button btn) override;
+        void render() override;
+        void onEnter() override;
+
+    private:
+        int topRow;
+        unsigned long lastSampleTime;
+        HeapSample now;
+    };
+
+    SavedListScreen savedList;
+    DiagnosticsScreen diagnostics;
 };
 
 // Global objects accessible from any file that includes main_menu.h
-extern Adafruit_SSD1306 display;
-extern ButtonManager buttonManager;
+extern ShadowedSSD1306 display;
 
 #endif
\ No newline at end of file
@@ -0,0 +1,143 @@
+#include "monitor.h"
+#include "config.h"
+#include "deauth_detector.h"
+#include "channel_hopper.h"
+#include "channel_analyzer.h"
+#include "power.h"
+#include <ESP8266WiFi.h>
+
+extern "C" {
+#include "user_interface.h"
+}
+
+// ===== SDK sniffer buffers =====
+// The SDK passes a 12-byte RxControl followed, depending on len, by the
+// start of the frame: 112 header bytes for management frames (len 128),
+// 36 for data frames, none for frames it could not decode (len 12).
+struct SnifferRxControl {
+    signed rssi:8;
+    unsigned rate:4;
+    unsigned is_group:1;
+    unsigned:1;
+    unsigned sig_mode:2;
+    unsigned legacy_length:12;
+    unsigned damatch0:1;
+    unsigned damatch1:1;
+    unsigned bssidmatch0:1;
+    unsigned bssidmatch1:1;
+    unsigned MCS:7;
+    unsigned CWB:1;
+    unsigned HT_length:16;
+    unsigned Smoothing:1;
+    unsigned Not_Sounding:1;
+    unsigned:1;
+    unsigned Aggregation:1;
+    unsigned STBC:2;
+    unsigned FEC_CODING:1;
+    unsigned SGI:1;
+    unsigned rxend_state:8;
+    unsigned ampdu_cnt:8;
+    unsigned channel:4;
+    unsigned:12;
+};
+
+#define SNIFFER_MGMT_LEN    128
+#define SNIFFER_MGMT_HEADER 112
+#define SNIFFER_DATA_HEADER 36
+
+FrameMonitor frameMonitor;
+volatile uint32_t FrameMonitor::frameCount = 0;
+
+FrameMonitor::FrameMonitor() :
+    running(false),
+    channel(WIFI_MIN_CHANNEL),
+    dwellStart(0),
+    dwellMs(MONITOR_DWELL_MS),
+    dwellFrames(0),
+    dwellDeauths(0)
+{
+}
+
+bool FrameMonitor::start() {
+    if (running) {
+        return true;
+    }
+    power.wakeRadio();
+    wifi_set_opmode_current(STATION_MODE);
+    wifi_promiscuous_enable(0);
+    FrameSummary stale;
+    while (frameRing.pop(stale)) {}   // Left from the last run
+    wifi_set_promiscuous_rx_cb(onRx);
+    wifi_promiscuous_enable(1);
+
+    running = true;
+    channelHopper.reset();
+    channelAnalyzer.reset();
+    deauthDetector.resetRates();
+    hop();
+    Serial.println(F("Monitor: started"));
+    return true;
+}
+
+void FrameMonitor::stop() {
+    if (!running) {
+        return;
+    }
+    wifi_promiscuous_enable(0);
+    wifi_set_promiscuous_rx_cb(nullptr);
+    running = false;
+    deauthDetector.clearAlert();
+    power.sleepRadio();
+    Serial.println(F("Monitor: stopped"));
+    channelHopper.printReport();
+}
+
+void FrameMonitor::poll() {
+    if (!running) {
+        return;
+    }
+
+    FrameSummary frame;
+    while (frameRing.pop(frame)) {
+        dwellFrames++;
+        channelAnalyzer.countFrame(frame);
+        uint8_t subtype = frame.subtype();
+        if (subtype == FRAME_DEAUTH || subtype == FRAME_DISASSOC) {
+            dwellDeauths++;
+            deauthDetector.countFrame(frame.addr3, frame.channel);  // addr3, the BSSID
+        }
+    }
+
+    unsigned long now = millis();
+    channelAnalyzer.update(channel, now);
+    unsigned long elapsed = now - dwellStart;
+    if (elapsed < dwellMs) {
+        return;
+    }
+
+    deauthDetector.endDwell(channel, elapsed);
+    channelHopper.endDwell(channel, elapsed, dwellFrames, dwellDeauths);
+    hop();
+}
+
+void FrameMonitor::hop() {
+    channel = channelHopper.next(dwellMs);
+    wifi_set_channel(channel);
+    dwellStart = millis();
+    dwellFrames = 0;
+    dwellDeauths = 0;
+}
+
+// Runs in the SDK's receive path for every frame the radio decodes. Keep
+// it to a copy into the ring.
+void IRAM_ATTR FrameMonitor::onRx(uint8_t* buf, uint16_t len) {
+    frameCount++;
+    if (len <= sizeof(SnifferRxControl)) {
+        return;   // No header to summarise
+    }
+
+    const SnifferRxControl* rx = (const SnifferRxControl*)buf;
+    uint8_t headerLen = len == SNIFFER_MGMT_LEN ? SNIFFER_MGMT_HEADER : SNIFFER_DATA_HEADER;
+    uint8_t rxChannel = rx->channel ? rx->channel : frameMonitor.channel;
+    frameRing.push(buf + sizeof(SnifferRxControl), headerLen, rx->rssi, rxChannel);
+}
@@ -0,0 +1,44 @@
+#ifndef MONITOR_H
+#define MONITOR_H
+
+#include <Arduino.h>
+#include "frame_ring.h"
+
+#define MONITOR_CHANNEL_SLOTS 15    // Per-channel arrays, indexed 1-14
+
+// Passive reception in promiscuous mode. The radio listens on one channel
+// at a time; channelHopper picks each channel and how long to stay. The
+// RX callback only copies a summary of each frame into frameRing; poll()
+// drains the ring into the detectors on every loop pass and closes the
+// dwell when it is due. Scanning needs the radio, so the two never run
+// together.
+class FrameMonitor {
+public:
+    FrameMonitor();
+
+    bool start();
+    void stop();
+    bool isRunning() const { return running; }
+    uint8_t getChannel() const { return channel; }
+
+    void poll();                        // Every loop pass
+
+    uint32_t getFrameCount() const { return frameCount; }   // Received, with or without a header
+
+private:
+    static void onRx(uint8_t* buf, uint16_t len);
+    void hop();
+
+    bool running;
+    uint8_t channel;
+    unsigned long dwellStart;
+    unsigned long dwellMs;      // Planned length of the running dwell
+    uint16_t dwellFrames;       // Heard in the running dwell
+    uint16_t dwellDeauths;
+
+    static volatile uint32_t frameCount;
+};
+
+extern FrameMonitor frameMonitor;
+
+#endif
@@ -0,0 +1,73 @@
+#include "network_record.h"
+#include <ESP8266WiFi.h>
+
+uint8_t encTypeFromWifi(uint8_t wifiEncType) {
+    switch (wifiEncType) {
+        case ENC_TYPE_NONE: return NET_ENC_OPEN;
+        case ENC_TYPE_WEP:  return NET_ENC_WEP;
+        case ENC_TYPE_TKIP: return NET_ENC_WPA;
+        case ENC_TYPE_CCMP: return NET_ENC_WPA2;
+        case ENC_TYPE_AUTO: return NET_ENC_WPA_WPA2;
+        default:            return NET_ENC_UNKNOWN;
+    }
+}
+
+void formatBssid(const uint8_t* bssid, char* out) {
+    sprintf(out, "%02X:%02X:%02X:%02X:%02X:%02X",
+            bssid[0], bssid[1], bssid[2], bssid[3], bssid[4], bssid[5]);
+}
+
+// List entry text, e.g. "HomeNet (-61 dBm)"
+void formatNetworkLabel(const NetworkRecord& net, const char* ssid, char* out, size_t size) {
+    if (net.ssidLen == 0) {
+        snprintf(out, size, "[Hidden] (%d dBm)", net.rssi);
+    } else {
+        snprintf(out, size, "%s (%d dBm)", ssid, net.rssi);
+    }
+}
+
+const __FlashStringHelper* encryptionName(uint8_t encType) {
+    switch (encType) {
+        case NET_ENC_OPEN:     return F("None");
+        case NET_ENC_WEP:      return F("WEP");
+        case NET_ENC_WPA:      return F("WPA/TKIP");
+        case NET_ENC_WPA2:     return F("WPA2/CCMP");
+        case NET_ENC_WPA_WPA2: return F("WPA/WPA2");
+        default:               return F("Unknown");
+    }
+}
+
+const __FlashStringHelper* securityProtocolName(uint8_t encType) {
+    switch (encType) {
+        case NET_ENC_OPEN:     return F("Open");
+        case NET_ENC_WEP:      return F("WEP");
+        case NET_ENC_WPA:      return F("WPA-PSK (TKIP)");
+        case NET_ENC_WPA2:     return F("WPA2-PSK (CCMP)");
+        case NET_ENC_WPA_WPA2: return F("WPA/WPA2-PSK");
+        default:               return F("Unknown");
+    }
+}
+
+const __FlashStringHelper* authModeName(uint8_t encType) {
+    switch (encType) {
+        case NET_ENC_OPEN:    return F("Open");
+        case NET_ENC_UNKNOWN: return F("Unknown");
+        default:              return F("Password");
+    }
+}
+
+int signalQuality(int rssi) {
+    return constrain(map(rssi, -100, -50, 0, 100), 0, 100);
+}
+
+// Rough free-space estimate from RSSI
+void formatDistance(int rssi, char* out, size_t size) {
+    float distance = pow(10, (-69 - (float)rssi) / (10 * 2));  // In meters
+    if (distance < 1) {
+        snprintf(out, size, "<1m");
+    } else if (distance > 100) {
+        snprintf(out, size, ">100m");
+    } else {
+        snprintf(out, size, "%dm", (int)distance);
+    }
+}
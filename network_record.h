@@ -0,0 +1,57 @@
+#ifndef NETWORK_RECORD_H
+#define NETWORK_RECORD_H
+
+#include <Arduino.h>
+
+// Security of an access point, as far as the scan reports it
+enum NetworkEnc : uint8_t {
+    NET_ENC_OPEN,
+    NET_ENC_WEP,
+    NET_ENC_WPA,
+    NET_ENC_WPA2,
+    NET_ENC_WPA_WPA2,
+    NET_ENC_UNKNOWN
+};
+
+// NetworkRecord::flags
+#define NET_FLAG_HIDDEN 0x01
+
+// Packed scan result. Everything shown on screen (quality, band, distance,
+// protocol names...) is derived from these fields when it is drawn. The
+// SSID text lives in the owning table's SsidPool.
+struct NetworkRecord {
+    uint8_t bssid[6];
+    int8_t rssi;          // Latest reading
+    int8_t bestRssi;
+    int8_t worstRssi;
+    uint8_t channel;
+    uint8_t encType;      // NetworkEnc
+    uint8_t flags;        // NET_FLAG_*
+    uint8_t ssidLen;      // 0 for a hidden network
+    uint16_t vendorId;    // From vendorLookup(), VENDOR_UNKNOWN if none
+    uint16_t seenCount;   // Number of sweeps that reported this BSSID
+    uint16_t ssidId;      // SsidPool id, SSID_NONE when ssidLen is 0
+    uint32_t firstSeen;   // millis() of the first sighting
+    uint32_t lastSeen;    // millis() of the latest sighting
+
+    bool isHidden() const { return (flags & NET_FLAG_HIDDEN) != 0; }
+    bool is5GHz() const { return channel > 14; }
+};
+
+// Ordered so the timestamps need no padding; every byte here is paid once
+// per table slot
+static_assert(sizeof(NetworkRecord) == 28, "NetworkRecord should pack to 28 bytes");
+
+// Map an ESP8266WiFi ENC_TYPE_* value onto NetworkEnc
+uint8_t encTypeFromWifi(uint8_t wifiEncType);
+
+// Text helpers - callers provide the buffer, nothing is allocated
+void formatBssid(const uint8_t* bssid, char* out);          // 18 bytes
+void formatNetworkLabel(const NetworkRecord& net, const char* ssid, char* out, size_t size);
+const __FlashStringHelper* encryptionName(uint8_t encType);
+const __FlashStringHelper* securityProtocolName(uint8_t encType);
+const __FlashStringHelper* authModeName(uint8_t encType);
+int signalQuality(int rssi);                                 // 0-100 %
+void formatDistance(int rssi, char* out, size_t size);
+
+#endif
@@ -0,0 +1,151 @@
+#include "network_sort.h"
+#include "vendor_db.h"
+
+const __FlashStringHelper* sortKeyName(uint8_t key) {
+    switch (key) {
+        case SORT_RSSI:      return F("Signal");
+        case SORT_CHANNEL:   return F("Channel");
+        case SORT_SSID:      return F("SSID");
+        case SORT_SECURITY:  return F("Security");
+        case SORT_VENDOR:    return F("Vendor");
+        case SORT_LAST_SEEN: return F("Last seen");
+        default:             return F("?");
+    }
+}
+
+// Negative when a belongs before b under the key, 0 when tied
+static int compareRecords(const NetworkTable& table, const NetworkRecord& a, const NetworkRecord& b, SortKey key) {
+    switch (key) {
+        case SORT_RSSI:
+            return b.rssi - a.rssi;
+        case SORT_CHANNEL:
+            return a.channel - b.channel;
+        case SORT_SSID:
+            if (a.ssidLen == 0 || b.ssidLen == 0) {
+                return (a.ssidLen == 0) - (b.ssidLen == 0);
+            }
+            if (a.ssidId == b.ssidId) {
+                return 0;  // Same interned ESSID
+            }
+            return strcasecmp(table.ssidOf(a), table.ssidOf(b));
+        case SORT_SECURITY:
+            return a.encType - b.encType;
+        case SORT_VENDOR:
+            // Vendor ids follow the name order of the OUI table
+            return (a.vendorId > b.vendorId) - (a.vendorId < b.vendorId);
+        case SORT_LAST_SEEN:
+            return (a.lastSeen < b.lastSeen) - (a.lastSeen > b.lastSeen);
+        default:
+            return 0;
+    }
+}
+
+NetworkOrder::NetworkOrder() :
+    index(nullptr),
+    scratch(nullptr),
+    count(0),
+    capacity(0),
+    key(SORT_RSSI),
+    dirty(true),
+    sortedVersion(0),
+    sortedLayout(0),
+    revision(0)
+{
+}
+
+size_t NetworkOrder::arenaBytes(int size) {
+    return 2 * ScanArena::footprint(size * sizeof(uint16_t));
+}
+
+bool NetworkOrder::begin(ScanArena& arena, int size) {
+    index = (uint16_t*)arena.alloc(size * sizeof(uint16_t));
+    scratch = (uint16_t*)arena.alloc(size * sizeof(uint16_t));
+    if (!index || !scratch) {
+        Serial.println(F("Sort index allocation failed"));
+        capacity = 0;
+        count = 0;
+        return false;
+    }
+    capacity = size;
+    count = 0;
+    dirty = true;
+    return true;
+}
+
+void NetworkOrder::setKey(SortKey newKey) {
+    if (newKey != key) {
+        key = newKey;
+        dirty = true;
+    }
+}
+
+bool NetworkOrder::update(const NetworkTable& table) {
+    int tableSize = min(table.size(), capacity);
+
+    if (table.getLayout() != sortedLayout || tableSize < count) {
+        // Entries moved - start again from table order
+        for (int i = 0; i < tableSize; i++) {
+            index[i] = i;
+        }
+        count = tableSize;
+        dirty = true;
+    } else if (tableSize > count) {
+        // New entries are appended to the table, so just add them
+        for (int i = count; i < tableSize; i++) {
+            index[i] = i;
+        }
+        count = tableSize;
+        dirty = true;
+    }
+
+    if (table.getVersion() != sortedVersion) {
+        dirty = true;
+    }
+    if (!dirty) {
+        return false;
+    }
+
+    sort(table);
+    sortedVersion = table.getVersion();
+    sortedLayout = table.getLayout();
+    dirty = false;
+    revision++;
+    return true;
+}
+
+// Bottom-up merge sort of the index array. Stable, no recursion, and the
+// only extra memory is the preallocated scratch buffer.
+void NetworkOrder::sort(const NetworkTable& table) {
+    uint16_t* src = index;
+    uint16_t* dst = scratch;
+
+    for (int width = 1; width < count; width *= 2) {
+        for (int low = 0; low < count; low += 2 * width) {
+            int mid = min(low + width, count);
+            int high = min(low + 2 * width, count);
+            int i = low;
+            int j = mid;
+            int k = low;
+
+            while (i < mid && j < high) {
+                // Take from the right run only when strictly smaller
+                if (compareRecords(table, table[src[j]], table[src[i]], key) < 0) {
+                    dst[k++] = src[j++];
+                } else {
+                    dst[k++] = src[i++];
+                }
+            }
+            while (i < mid) dst[k++] = src[i++];
+            while (j < high) dst[k++] = src[j++];
+        }
+
+        uint16_t* swap = src;
+        src = dst;
+        dst = swap;
+        yield();
+    }
+
+    if (src != index) {
+        memcpy(index, src, count * sizeof(uint16_t));
+    }
+}
@@ -0,0 +1,55 @@
+#ifndef NETWORK_SORT_H
+#define NETWORK_SORT_H
+
+#include <Arduino.h>
+#include "network_table.h"
+
+// Keys the network list can be ordered by
+enum SortKey : uint8_t {
+    SORT_RSSI,       // Strongest first
+    SORT_CHANNEL,    // Lowest channel first
+    SORT_SSID,       // A-Z, case-insensitive, hidden last
+    SORT_SECURITY,   // Open first, then WEP, WPA, WPA2...
+    SORT_VENDOR,     // A-Z by vendor name, unknown last
+    SORT_LAST_SEEN,  // Most recently seen first
+    SORT_KEY_COUNT
+};
+
+const __FlashStringHelper* sortKeyName(uint8_t key);
+
+// Display order of a NetworkTable, kept as a permutation of table indices.
+// Sorting moves 2-byte indices instead of records, is stable (ties keep
+// their previous order) and only runs when the table or the key changed.
+class NetworkOrder {
+public:
+    NetworkOrder();
+
+    bool begin(ScanArena& arena, int capacity);
+    static size_t arenaBytes(int capacity);
+
+    void setKey(SortKey key);
+    SortKey getKey() const { return key; }
+
+    // Bring the order up to date with the table. Returns true if it was
+    // re-sorted, false if nothing had changed.
+    bool update(const NetworkTable& table);
+
+    int size() const { return count; }
+    uint16_t operator[](int position) const { return index[position]; }
+    uint32_t getRevision() const { return revision; }  // Moves on every re-sort
+
+private:
+    void sort(const NetworkTable& table);
+
+    uint16_t* index;
+    uint16_t* scratch;   // Merge buffer, same size as index
+    int count;
+    int capacity;
+    SortKey key;
+    bool dirty;
+    uint32_t sortedVersion;
+    uint32_t sortedLayout;
+    uint32_t revision;
+};
+
+#endif
@@ -0,0 +1,175 @@
+#include "network_table.h"
+#include "config.h"
+
+NetworkTable::NetworkTable() :
+    entries(nullptr),
+    count(0),
+    capacity(0),
+    evicted(0),
+    dropped(0),
+    version(0),
+    layout(0)
+{
+}
+
+bool NetworkTable::begin(ScanArena& arena, int size, size_t ssidBytes) {
+    count = 0;
+    layout++;
+    version++;
+
+    // One spare pool slot: a newcomer's SSID is interned before the entry
+    // it replaces gives its own up
+    entries = (NetworkRecord*)arena.alloc(size * sizeof(NetworkRecord));
+    if (!entries || !ssids.begin(arena, size + 1, ssidBytes)) {
+        Serial.println(F("Network table allocation failed"));
+        entries = nullptr;
+        capacity = 0;
+        return false;
+    }
+    capacity = size;
+    return true;
+}
+
+size_t NetworkTable::arenaBytes(int size, size_t ssidBytes) {
+    return ScanArena::footprint(size * sizeof(NetworkRecord)) + SsidPool::arenaBytes(size + 1, ssidBytes);
+}
+
+void NetworkTable::clear() {
+    count = 0;
+    ssids.clear();
+    layout++;
+    version++;
+}
+
+int NetworkTable::find(const uint8_t* bssid) const {
+    for (int i = 0; i < count; i++) {
+        if (memcmp(entries[i].bssid, bssid, sizeof(entries[i].bssid)) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+int NetworkTable::merge(const NetworkRecord& sighting, const char* ssid) {
+    int index = find(sighting.bssid);
+
+    if (index >= 0) {
+        // Known BSSID - refresh the live fields and extend the history
+        NetworkRecord& net = entries[index];
+        net.rssi = sighting.rssi;
+        if (sighting.rssi > net.bestRssi) net.bestRssi = sighting.rssi;
+        if (sighting.rssi < net.worstRssi) net.worstRssi = sighting.rssi;
+        net.channel = sighting.channel;
+        net.encType = sighting.encType;
+        net.flags = sighting.flags;
+        net.lastSeen = sighting.lastSeen;
+        if (net.seenCount < 0xFFFF) net.seenCount++;
+
+        // A hidden AP may answer a probe with its name later on. If the
+        // pool is full the old name is simply kept.
+        if (sighting.ssidLen > 0 && (sighting.ssidLen != net.ssidLen ||
+                                     memcmp(ssids.get(net.ssidId), ssid, net.ssidLen) != 0)) {
+            uint16_t id = ssids.intern(ssid, sighting.ssidLen);
+            if (id != SSID_NONE) {
+                ssids.release(net.ssidId);
+                net.ssidId = id;
+                net.ssidLen = sighting.ssidLen;
+            }
+        }
+        version++;
+        return index;
+    }
+
+    bool full = count >= capacity;
+    index = full ? pickVictim(sighting) : count;
+    if (index < 0) {
+        dropped++;
+        return -1;
+    }
+
+    uint16_t ssidId = SSID_NONE;
+    if (sighting.ssidLen > 0) {
+        ssidId = ssids.intern(ssid, sighting.ssidLen);
+        if (ssidId == SSID_NONE) {
+            dropped++;
+            return -1;
+        }
+    }
+
+    NetworkRecord& net = entries[index];
+    if (full) {
+        ssids.release(net.ssidId);
+        evicted++;
+    } else {
+        count++;
+    }
+
+    net = sighting;
+    net.ssidId = ssidId;
+    net.bestRssi = sighting.rssi;
+    net.worstRssi = sighting.rssi;
+    net.firstSeen = sighting.lastSeen;
+    net.seenCount = 1;
+    version++;
+    return index;
+}
+
+// Choose an entry to replace when full: the longest-unseen stale entry
+// first, otherwise the weakest one if the newcomer is stronger
+int NetworkTable::pickVictim(const NetworkRecord& sighting) const {
+    int oldest = -1;
+    int weakest = -1;
+
+    for (int i = 0; i < count; i++) {
+        const NetworkRecord& net = entries[i];
+        if (sighting.lastSeen - net.lastSeen >= NETWORK_STALE_MS) {
+            if (oldest < 0 || net.lastSeen < entries[oldest].lastSeen) {
+                oldest = i;
+            }
+        }
+        if (weakest < 0 || net.rssi < entries[weakest].rssi) {
+            weakest = i;
+        }
+    }
+
+    if (oldest >= 0) {
+        return oldest;
+    }
+    if (weakest >= 0 && entries[weakest].rssi < sighting.rssi) {
+        return weakest;
+    }
+    return -1;
+}
+
+int NetworkTable::expire(uint32_t now, uint32_t maxAge) {
+    int kept = 0;
+    for (int i = 0; i < count; i++) {
+        if (now - entries[i].lastSeen < maxAge) {
+            if (kept != i) {
+                entries[kept] = entries[i];
+            }
+            kept++;
+        } else {
+            ssids.release(entries[i].ssidId);
+        }
+    }
+
+    int removed = count - kept;
+    count = kept;
+    if (removed > 0) {
+        layout++;
+        version++;
+    }
+    return removed;
+}
+
+void NetworkTable::truncate(int newCount) {
+    if (newCount >= 0 && newCount < count) {
+        for (int i = newCount; i < count; i++) {
+            ssids.release(entries[i].ssidId);
+        }
+        count = newCount;
+        layout++;
+        version++;
+    }
+}
@@ -0,0 +1,63 @@
+#ifndef NETWORK_TABLE_H
+#define NETWORK_TABLE_H
+
+#include <Arduino.h>
+#include "network_record.h"
+#include "scan_arena.h"
+#include "ssid_pool.h"
+
+// Persistent list of access points keyed by BSSID. Every scan is merged
+// into it, so entries keep their history (first/last seen, seen count,
+// RSSI range) across sweeps instead of being rebuilt each time. Records
+// and SSID text are carved from the scan arena once, in begin().
+class NetworkTable {
+public:
+    NetworkTable();
+
+    bool begin(ScanArena& arena, int capacity, size_t ssidBytes);
+    static size_t arenaBytes(int capacity, size_t ssidBytes);
+    void clear();
+
+    // Merge one sighting with its SSID text (ssidLen bytes). Returns the
+    // entry's index, or -1 if it was dropped: the table is full and nothing
+    // could be evicted, or the SSID pool is out of space.
+    int merge(const NetworkRecord& sighting, const char* ssid);
+
+    // Drop entries not seen for maxAge ms. Returns how many were removed.
+    int expire(uint32_t now, uint32_t maxAge);
+
+    // Keep only the first count entries (used by in-place compaction)
+    void truncate(int count);
+
+    int find(const uint8_t* bssid) const;
+    int size() const { return count; }
+    int getCapacity() const { return capacity; }
+    unsigned long getEvictedCount() const { return evicted; }
+    unsigned long getDroppedCount() const { return dropped; }
+
+    const char* ssidOf(const NetworkRecord& net) const { return ssids.get(net.ssidId); }
+    const SsidPool& getSsidPool() const { return ssids; }
+
+    // Change counters for views built on top of the table (sort order,
+    // filter results). version moves on any data change, layout when
+    // existing entries change index (compaction, clear).
+    uint32_t getVersion() const { return version; }
+    uint32_t getLayout() const { return layout; }
+
+    NetworkRecord& operator[](int index) { return entries[index]; }
+    const NetworkRecord& operator[](int index) const { return entries[index]; }
+
+private:
+    int pickVictim(const NetworkRecord& sighting) const;
+
+    NetworkRecord* entries;
+    SsidPool ssids;
+    int count;
+    int capacity;
+    unsigned long evicted;
+    unsigned long dropped;
+    uint32_t version;
+    uint32_t layout;
+};
+
+#endif
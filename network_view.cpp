@@ -0,0 +1,78 @@
+#include "network_view.h"
+
+NetworkView::NetworkView() :
+    matchBits(nullptr),
+    visible(nullptr),
+    count(0),
+    capacity(0),
+    predicate(nullptr),
+    predicateContext(nullptr),
+    filterDirty(true),
+    matchedVersion(0),
+    orderRevision(0)
+{
+}
+
+size_t NetworkView::arenaBytes(int size) {
+    return ScanArena::footprint(((size + 31) / 32) * sizeof(uint32_t)) + ScanArena::footprint(size * sizeof(uint16_t));
+}
+
+bool NetworkView::begin(ScanArena& arena, int size) {
+    matchBits = (uint32_t*)arena.alloc(((size + 31) / 32) * sizeof(uint32_t));
+    visible = (uint16_t*)arena.alloc(size * sizeof(uint16_t));
+    if (!matchBits || !visible) {
+        Serial.println(F("Filter view allocation failed"));
+        capacity = 0;
+        count = 0;
+        return false;
+    }
+    capacity = size;
+    count = 0;
+    filterDirty = true;
+    return true;
+}
+
+void NetworkView::setFilter(NetworkPredicate newPredicate, const void* context) {
+    predicate = newPredicate;
+    predicateContext = context;
+    filterDirty = true;
+}
+
+void NetworkView::invalidate() {
+    filterDirty = true;
+}
+
+bool NetworkView::matches(int tableIndex) const {
+    return (matchBits[tableIndex / 32] >> (tableIndex % 32)) & 1;
+}
+
+bool NetworkView::update(const NetworkTable& table, const NetworkOrder& order) {
+    bool rematch = filterDirty || table.getVersion() != matchedVersion;
+    if (!rematch && order.getRevision() == orderRevision) {
+        return false;
+    }
+
+    int entries = min(table.size(), capacity);
+
+    if (rematch) {
+        memset(matchBits, 0, ((capacity + 31) / 32) * sizeof(uint32_t));
+        for (int i = 0; i < entries; i++) {
+            if (!predicate || predicate(table[i], predicateContext)) {
+                matchBits[i / 32] |= (uint32_t)1 << (i % 32);
+            }
+        }
+        matchedVersion = table.getVersion();
+        filterDirty = false;
+    }
+
+    // Walk the sorted order and keep the matches
+    count = 0;
+    for (int i = 0; i < order.size(); i++) {
+        uint16_t index = order[i];
+        if (index < entries && matches(index)) {
+            visible[count++] = index;
+        }
+    }
+    orderRevision = order.getRevision();
+    return true;
+}
@@ -0,0 +1,43 @@
+#ifndef NETWORK_VIEW_H
+#define NETWORK_VIEW_H
+
+#include <Arduino.h>
+#include "network_table.h"
+#include "network_sort.h"
+
+typedef bool (*NetworkPredicate)(const NetworkRecord& net, const void* context);
+
+// Filtered view of a NetworkTable in NetworkOrder order. The table is never
+// modified: each entry gets a match bit, and the view is the sorted order
+// with non-matching entries skipped. Both are rebuilt only when the table,
+// the order or the filter settings changed.
+class NetworkView {
+public:
+    NetworkView();
+
+    bool begin(ScanArena& arena, int capacity);
+    static size_t arenaBytes(int capacity);
+
+    void setFilter(NetworkPredicate predicate, const void* context);
+    void invalidate();  // Filter settings changed - re-test every entry
+
+    // Bring the view up to date. Returns true if it changed.
+    bool update(const NetworkTable& table, const NetworkOrder& order);
+
+    int size() const { return count; }
+    uint16_t operator[](int position) const { return visible[position]; }  // Table index
+    bool matches(int tableIndex) const;
+
+private:
+    uint32_t* matchBits;   // One bit per table entry
+    uint16_t* visible;     // Matching table indices in display order
+    int count;
+    int capacity;
+    NetworkPredicate predicate;
+    const void* predicateContext;
+    bool filterDirty;
+    uint32_t matchedVersion;
+    uint32_t orderRevision;
+};
+
+#endif
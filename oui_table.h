@@ -0,0 +1,53 @@
+// Generated by tools/gen_oui.py from oui_seed.csv - do not edit
+#ifndef OUI_TABLE_H
+#define OUI_TABLE_H
+
+#include <Arduino.h>
+
+#define OUI_ENTRY_COUNT  26
+#define OUI_VENDOR_COUNT 17
+
+static const uint8_t OUI_PREFIXES[OUI_ENTRY_COUNT * 3] PROGMEM = {
+    0x00,0x11,0x22, 0x00,0x13,0x10, 0x00,0x18,0x4D, 0x00,0x1F,0x90,
+    0x00,0x25,0x9C, 0x00,0x26,0x37, 0x00,0x50,0xBA, 0x00,0x90,0x4C,
+    0x08,0x86,0x3B, 0x0C,0x80,0x63, 0x0C,0xD2,0x92, 0x18,0xE8,0x29,
+    0x1C,0xB7,0x2C, 0x30,0xAE,0xA4, 0x38,0x60,0x77, 0x50,0xC7,0xBF,
+    0x5C,0xCF,0x7F, 0x60,0x38,0xE0, 0x64,0x09,0x80, 0x74,0xDA,0x38,
+    0x94,0x10,0x3E, 0xAC,0x72,0x89, 0xD0,0x15,0x4A, 0xD8,0x0D,0x17,
+    0xDC,0xA6,0x32, 0xF0,0x9F,0xC2,
+};
+
+static const uint16_t OUI_VENDOR[OUI_ENTRY_COUNT] PROGMEM = {
+    3, 10, 11, 5, 4, 13, 5, 7, 2, 14, 9, 15,
+    0, 8, 1, 14, 8, 2, 16, 6, 2, 9, 14, 14,
+    12, 15,
+};
+
+typedef uint16_t oui_name_offset_t;
+
+static const oui_name_offset_t OUI_NAME_OFFS[OUI_VENDOR_COUNT] PROGMEM = {
+    0, 8, 14, 21, 27, 41, 48, 55, 63, 73, 79, 87,
+    95, 108, 116, 124, 133,
+};
+
+static const char OUI_NAME_POOL[] PROGMEM =
+    "ASUSTek\0"
+    "Apple\0"
+    "Belkin\0"
+    "Cisco\0"
+    "Cisco-Linksys\0"
+    "D-Link\0"
+    "Edimax\0"
+    "Epigram\0"
+    "Espressif\0"
+    "Intel\0"
+    "Linksys\0"
+    "Netgear\0"
+    "Raspberry Pi\0"
+    "Samsung\0"
+    "TP-Link\0"
+    "Ubiquiti\0"
+    "Xiaomi\0"
+    ;
+
+#endif
@@ -0,0 +1,172 @@
+#include "power.h"
+#include "config.h"
+#include "main_menu.h"
+#include <ESP8266WiFi.h>
+extern "C" {
+#include "gpio.h"
+}
+
+// Choices behind Settings > TimeOut Settings; 0 keeps the display on
+static const unsigned long DISPLAY_TIMEOUTS[] = { 15000, 30000, 60000, 300000, 0 };
+static const uint8_t DISPLAY_TIMEOUT_COUNT = sizeof(DISPLAY_TIMEOUTS) / sizeof(DISPLAY_TIMEOUTS[0]);
+
+PowerManager power;
+
+PowerManager::PowerManager() :
+    buttons(nullptr),
+    displayState(DISPLAY_ON),
+    timeoutIndex(0),
+    lastActivity(0),
+    radioAsleep(false)
+{
+    for (uint8_t i = 0; i < DISPLAY_TIMEOUT_COUNT; i++) {
+        if (DISPLAY_TIMEOUTS[i] == POWER_DISPLAY_TIMEOUT_MS) {
+            timeoutIndex = i;
+        }
+    }
+}
+
+void PowerManager::begin(ButtonManager& buttonManager) {
+    buttons = &buttonManager;
+    lastActivity = millis();
+    sleepRadio();  // Nothing scans until asked to
+}
+
+// ===== Radio =====
+
+void PowerManager::wakeRadio() {
+    if (!radioAsleep) {
+        return;
+    }
+    WiFi.forceSleepWake();
+    radioAsleep = false;
+}
+
+void PowerManager::sleepRadio() {
+    if (radioAsleep) {
+        return;
+    }
+    radioAsleep = WiFi.forceSleepBegin();
+}
+
+// ===== Display =====
+
+bool PowerManager::onKey() {
+    lastActivity = millis();
+    bool wasBlank = displayState == DISPLAY_BLANK;
+    setDisplayState(DISPLAY_ON);
+    return wasBlank;
+}
+
+void PowerManager::wakeDisplay() {
+    lastActivity = millis();
+    setDisplayState(DISPLAY_ON);
+}
+
+// The panel keeps its RAM while off, so waking it needs no redraw
+void PowerManager::setDisplayState(DisplayState state) {
+    if (state == displayState) {
+        return;
+    }
+    if (displayState == DISPLAY_BLANK) {
+        display.ssd1306_command(SSD1306_DISPLAYON);
+    }
+
+    switch (state) {
+        case DISPLAY_ON:
+            display.dim(false);
+            break;
+        case DISPLAY_DIMMED:
+            display.dim(true);
+            break;
+        case DISPLAY_BLANK:
+            display.ssd1306_command(SSD1306_DISPLAYOFF);
+            break;
+    }
+    displayState = state;
+}
+
+void PowerManager::update(bool idle) {
+    unsigned long timeout = getDisplayTimeout();
+    if (timeout > 0) {
+        unsigned long idleFor = millis() - lastActivity;
+        if (displayState == DISPLAY_ON && idleFor >= timeout) {
+            setDisplayState(DISPLAY_DIMMED);
+        } else if (displayState == DISPLAY_DIMMED && idleFor >= timeout + POWER_BLANK_AFTER_DIM_MS) {
+            setDisplayState(DISPLAY_BLANK);
+        }
+    }
+
+    if (displayState == DISPLAY_BLANK && idle && radioAsleep) {
+        lightSleep();
+    }
+}
+
+const __FlashStringHelper* PowerManager::nextDisplayTimeout() {
+    timeoutIndex = (timeoutIndex + 1) % DISPLAY_TIMEOUT_COUNT;
+    lastActivity = millis();
+    snapshot(journal);
+    switch (DISPLAY_TIMEOUTS[timeoutIndex]) {
+        case 15000:  return F("Dim after 15 s");
+        case 30000:  return F("Dim after 30 s");
+        case 60000:  return F("Dim after 1 min");
+        case 300000: return F("Dim after 5 min");
+        default:     return F("Display always on");
+    }
+}
+
+unsigned long PowerManager::getDisplayTimeout() const {
+    return DISPLAY_TIMEOUTS[timeoutIndex];
+}
+
+// JOURNAL_DISPLAY holds the timeout itself, so the choices can change
+void PowerManager::restore(uint8_t type, const uint8_t* data, uint8_t len) {
+    if (type != JOURNAL_DISPLAY || len != sizeof(uint32_t)) {
+        return;
+    }
+    uint32_t timeout;
+    memcpy(&timeout, data, sizeof(timeout));
+    for (uint8_t i = 0; i < DISPLAY_TIMEOUT_COUNT; i++) {
+        if (DISPLAY_TIMEOUTS[i] == timeout) {
+            timeoutIndex = i;
+        }
+    }
+}
+
+void PowerManager::snapshot(Journal& journal) {
+    uint32_t timeout = DISPLAY_TIMEOUTS[timeoutIndex];
+    journal.append(JOURNAL_DISPLAY, &timeout, sizeof(timeout));
+}
+
+// ===== Light sleep =====
+
+// Forced light sleep: the CPU stops inside the delay() below and a low
+// level on any button pin brings it back within a few ms. The modem is
+// already off (NULL_MODE) from sleepRadio(), which light sleep requires;
+// its modem-sleep session is closed first since only one can be open.
+// The wake-up setup replaces the pins' edge interrupts, so the buttons
+// are re-armed afterwards. The key that woke us is picked up by
+// readButton() re-reading the pins.
+void PowerManager::lightSleep() {
+    buttons->suspend();
+    wifi_fpm_do_wakeup();
+    wifi_fpm_close();
+
+    wifi_fpm_set_sleep_type(LIGHT_SLEEP_T);
+    wifi_fpm_open();
+    gpio_pin_wakeup_enable(GPIO_ID_PIN(BUTTON_UP_PIN), GPIO_PIN_INTR_LOLEVEL);
+    gpio_pin_wakeup_enable(GPIO_ID_PIN(BUTTON_DOWN_PIN), GPIO_PIN_INTR_LOLEVEL);
+    gpio_pin_wakeup_enable(GPIO_ID_PIN(BUTTON_SELECT_PIN), GPIO_PIN_INTR_LOLEVEL);
+    gpio_pin_wakeup_enable(GPIO_ID_PIN(BUTTON_BACK_PIN), GPIO_PIN_INTR_LOLEVEL);
+    wifi_fpm_do_sleep(0xFFFFFFF);
+    delay(POWER_SLEEP_ENTRY_MS);
+
+    gpio_pin_wakeup_disable();
+    wifi_fpm_close();
+    buttons->resume();
+
+    // Back to plain modem sleep until the next sweep
+    wifi_fpm_set_sleep_type(MODEM_SLEEP_T);
+    wifi_fpm_open();
+    wifi_fpm_do_sleep(0xFFFFFFF);
+}
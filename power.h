@@ -0,0 +1,59 @@
+#ifndef POWER_H
+#define POWER_H
+
+#include <Arduino.h>
+#include "ButtonManager.h"
+#include "journal.h"
+
+// Battery saving. The radio sits in forced modem sleep whenever no sweep
+// is running, the OLED dims and then blanks after a spell without key
+// presses, and once it is blank with nothing scheduled the chip light-
+// sleeps until a button pulls its pin low.
+class PowerManager : public JournalClient {
+public:
+    enum DisplayState {
+        DISPLAY_ON,
+        DISPLAY_DIMMED,
+        DISPLAY_BLANK
+    };
+
+    PowerManager();
+
+    void begin(ButtonManager& buttons);
+
+    // Around every sweep
+    void wakeRadio();
+    void sleepRadio();
+    bool isRadioAsleep() const { return radioAsleep; }
+
+    // Every key press. True when it only woke a blank display, so the
+    // caller should drop it.
+    bool onKey();
+    void wakeDisplay();          // Something worth seeing happened
+
+    // Call every loop pass; idle means nothing needs the CPU until a key
+    void update(bool idle);
+
+    DisplayState getDisplayState() const { return displayState; }
+
+    // Settings > TimeOut Settings
+    const __FlashStringHelper* nextDisplayTimeout();
+    unsigned long getDisplayTimeout() const;
+
+    void restore(uint8_t type, const uint8_t* data, uint8_t len) override;
+    void snapshot(Journal& journal) override;
+
+private:
+    void setDisplayState(DisplayState state);
+    void lightSleep();
+
+    ButtonManager* buttons;
+    DisplayState displayState;
+    uint8_t timeoutIndex;
+    unsigned long lastActivity;
+    bool radioAsleep;
+};
+
+extern PowerManager power;
+
+#endif
@@ -0,0 +1,114 @@
+#include "saved_networks.h"
+#include "config.h"
+#include "telemetry.h"
+
+// JOURNAL_NET_ADD payload, followed by ssidLen SSID bytes
+struct SavedNetworkRecord {
+    uint8_t bssid[6];
+    uint8_t channel;
+    uint8_t ssidLen;
+};
+
+static bool appendNetwork(Journal& journal, const SavedNetwork& net) {
+    uint8_t record[sizeof(SavedNetworkRecord) + sizeof(net.ssid) - 1];
+    SavedNetworkRecord* head = (SavedNetworkRecord*)record;
+    memcpy(head->bssid, net.bssid, sizeof(head->bssid));
+    head->channel = net.channel;
+    head->ssidLen = net.ssidLen;
+    memcpy(record + sizeof(SavedNetworkRecord), net.ssid, net.ssidLen);
+    return journal.append(JOURNAL_NET_ADD, record, sizeof(SavedNetworkRecord) + net.ssidLen);
+}
+
+SavedNetworks savedNetworks;
+
+SavedNetworks::SavedNetworks() :
+    networkCount(0),
+    revision(0)
+{
+}
+
+int SavedNetworks::indexOf(const uint8_t* bssid) const {
+    for (int i = 0; i < networkCount; i++) {
+        if (memcmp(networks[i].bssid, bssid, sizeof(networks[i].bssid)) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+bool SavedNetworks::add(const uint8_t* bssid, const char* ssid, uint8_t ssidLen, uint8_t channel) {
+    TelemetryScope telemetryScope(TEL_OP_SAVE_NETWORK);
+    if (indexOf(bssid) < 0 && networkCount >= MAX_NETWORKS) {
+        Serial.println(F("Maximum networks reached, replacing oldest entry"));
+    }
+    insert(bssid, ssid, ssidLen, channel);
+    return appendNetwork(journal, networks[networkCount - 1]);
+}
+
+bool SavedNetworks::remove(int index) {
+    if (index < 0 || index >= networkCount) {
+        return false;
+    }
+    uint8_t bssid[6];
+    memcpy(bssid, networks[index].bssid, sizeof(bssid));
+    drop(index);
+    return journal.append(JOURNAL_NET_REMOVE, bssid, sizeof(bssid));
+}
+
+bool SavedNetworks::clear() {
+    networkCount = 0;
+    revision++;
+    return journal.append(JOURNAL_NET_CLEAR, nullptr, 0);
+}
+
+void SavedNetworks::restore(uint8_t type, const uint8_t* data, uint8_t len) {
+    if (type == JOURNAL_NET_ADD && len >= sizeof(SavedNetworkRecord)) {
+        const SavedNetworkRecord* head = (const SavedNetworkRecord*)data;
+        uint8_t ssidLen = min((int)head->ssidLen, len - (int)sizeof(SavedNetworkRecord));
+        insert(head->bssid, (const char*)data + sizeof(SavedNetworkRecord), ssidLen, head->channel);
+    } else if (type == JOURNAL_NET_REMOVE && len == 6) {
+        int index = indexOf(data);
+        if (index >= 0) {
+            drop(index);
+        }
+    } else if (type == JOURNAL_NET_CLEAR) {
+        networkCount = 0;
+        revision++;
+    }
+}
+
+// Adding them oldest first rebuilds the same order
+void SavedNetworks::snapshot(Journal& journal) {
+    for (int i = 0; i < networkCount; i++) {
+        appendNetwork(journal, networks[i]);
+    }
+}
+
+void SavedNetworks::insert(const uint8_t* bssid, const char* ssid, uint8_t ssidLen, uint8_t channel) {
+    if (ssidLen > sizeof(networks[0].ssid) - 1) {
+        ssidLen = sizeof(networks[0].ssid) - 1;
+    }
+
+    int existing = indexOf(bssid);
+    if (existing >= 0) {
+        drop(existing);
+    } else if (networkCount >= MAX_NETWORKS) {
+        drop(0);
+    }
+
+    SavedNetwork& net = networks[networkCount++];
+    memcpy(net.bssid, bssid, sizeof(net.bssid));
+    net.channel = channel;
+    net.ssidLen = ssidLen;
+    memcpy(net.ssid, ssid, ssidLen);
+    net.ssid[ssidLen] = '\0';
+    revision++;
+}
+
+void SavedNetworks::drop(int index) {
+    for (int i = index; i < networkCount - 1; i++) {
+        networks[i] = networks[i + 1];
+    }
+    networkCount--;
+    revision++;
+}
@@ -0,0 +1,53 @@
+#ifndef SAVED_NETWORKS_H
+#define SAVED_NETWORKS_H
+
+#include <Arduino.h>
+#include "journal.h"
+
+#define MAX_NETWORKS 5
+
+// One network saved for deauth, as kept in RAM
+struct SavedNetwork {
+    uint8_t bssid[6];
+    uint8_t channel;
+    uint8_t ssidLen;
+    char ssid[33];        // NUL-terminated
+
+    bool isHidden() const { return ssidLen == 0; }
+};
+
+// Networks saved for deauth, oldest first. The list lives in RAM; each
+// change is also appended to the journal as one small record, and the
+// journal replays them at boot.
+class SavedNetworks : public JournalClient {
+public:
+    SavedNetworks();
+
+    int count() const { return networkCount; }
+    const SavedNetwork& get(int index) const { return networks[index]; }
+    int indexOf(const uint8_t* bssid) const;   // -1 if not saved
+    bool contains(const uint8_t* bssid) const { return indexOf(bssid) >= 0; }
+    uint16_t getRevision() const { return revision; }   // Moves on every change
+
+    // Saving a BSSID again moves it to the newest slot; when the list is
+    // full the oldest network makes room
+    bool add(const uint8_t* bssid, const char* ssid, uint8_t ssidLen, uint8_t channel);
+    bool remove(int index);
+    bool clear();
+
+    void restore(uint8_t type, const uint8_t* data, uint8_t len) override;
+    void snapshot(Journal& journal) override;
+
+private:
+    // RAM only
+    void insert(const uint8_t* bssid, const char* ssid, uint8_t ssidLen, uint8_t channel);
+    void drop(int index);
+
+    SavedNetwork networks[MAX_NETWORKS];
+    uint8_t networkCount;
+    uint16_t revision;
+};
+
+extern SavedNetworks savedNetworks;
+
+#endif
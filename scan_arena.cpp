@@ -0,0 +1,39 @@
+#include "scan_arena.h"
+#include <new>
+
+ScanArena::ScanArena() :
+    block(nullptr),
+    size(0),
+    used(0)
+{
+}
+
+ScanArena::~ScanArena() {
+    delete[] block;
+}
+
+bool ScanArena::begin(size_t bytes) {
+    delete[] block;
+    block = new (std::nothrow) uint8_t[bytes];
+    used = 0;
+    if (!block) {
+        Serial.println(F("Scan arena allocation failed"));
+        size = 0;
+        return false;
+    }
+    size = bytes;
+    return true;
+}
+
+void ScanArena::reset() {
+    used = 0;
+}
+
+void* ScanArena::alloc(size_t bytes) {
+    size_t start = footprint(used);
+    if (!block || start + bytes > size) {
+        return nullptr;
+    }
+    used = start + bytes;
+    return block + start;
+}
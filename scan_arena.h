@@ -0,0 +1,33 @@
+#ifndef SCAN_ARENA_H
+#define SCAN_ARENA_H
+
+#include <Arduino.h>
+
+// One heap block, allocated once at boot and carved up by the scan storage
+// (network table, SSID pool, sort order, filter view). Nothing is freed
+// piecemeal, so the heap cannot fragment around the scan data; reset()
+// gives the whole block back for re-carving.
+class ScanArena {
+public:
+    ScanArena();
+    ~ScanArena();
+
+    bool begin(size_t bytes);
+    void reset();
+
+    // Take bytes from the block, 4-byte aligned. nullptr when exhausted.
+    void* alloc(size_t bytes);
+
+    // Arena space alloc() uses for bytes, alignment included
+    static size_t footprint(size_t bytes) { return (bytes + 3) & ~(size_t)3; }
+
+    size_t getSize() const { return size; }
+    size_t getUsed() const { return used; }
+
+private:
+    uint8_t* block;
+    size_t size;
+    size_t used;
+};
+
+#endif
@@ -0,0 +1,343 @@
+#include "scan_engine.h"
+#include <ESP8266WiFi.h>
+
+extern "C" {
+#include "user_interface.h"
+}
+
+// ===== SDK callback hand-off =====
+// The SDK reports a finished channel from its own task with a bss_info list
+// that is only valid during the callback, so it is copied here and picked
+// up by update() on the next loop.
+static ScanResult pendingResults[SCAN_RESULT_BUFFER];
+static volatile uint8_t pendingCount = 0;
+static volatile uint8_t pendingOverflow = 0;
+static volatile bool pendingDone = false;
+static volatile bool pendingFailed = false;
+
+static volatile bool scanInFlight = false;
+
+// Every SDK scan request gets the next generation number. The SDK runs one
+// scan at a time and reports them in order, so the callback counts its
+// reports to know which request it is answering and only takes the latest
+// one - a channel given up on may still report late, and must not be
+// credited to the next one.
+static volatile uint16_t scansIssued = 0;
+static volatile uint16_t scansReported = 0;
+
+static uint8_t encTypeFromAuth(AUTH_MODE mode) {
+    switch (mode) {
+        case AUTH_OPEN:         return ENC_TYPE_NONE;
+        case AUTH_WEP:          return ENC_TYPE_WEP;
+        case AUTH_WPA_PSK:      return ENC_TYPE_TKIP;
+        case AUTH_WPA2_PSK:     return ENC_TYPE_CCMP;
+        case AUTH_WPA_WPA2_PSK: return ENC_TYPE_AUTO;
+        default:                return 255;
+    }
+}
+
+static void onSdkScanDone(void* arg, STATUS status) {
+    uint16_t scan = ++scansReported;
+    if (!scanInFlight || scan != scansIssued) {
+        return;  // Channel already given up on
+    }
+
+    uint8_t count = 0;
+    uint8_t overflow = 0;
+    if (status == OK) {
+        for (bss_info* it = (bss_info*)arg; it; it = STAILQ_NEXT(it, next)) {
+            if (count == SCAN_RESULT_BUFFER) {
+                if (overflow < 0xFF) overflow++;
+                continue;
+            }
+            ScanResult& result = pendingResults[count++];
+            memcpy(result.bssid, it->bssid, sizeof(result.bssid));
+            uint8_t len = min((int)it->ssid_len, (int)sizeof(result.ssid) - 1);
+            memcpy(result.ssid, it->ssid, len);
+            result.ssid[len] = '\0';
+            result.rssi = it->rssi;
+            result.channel = it->channel;
+            result.encType = encTypeFromAuth(it->authmode);
+            result.isHidden = it->is_hidden;
+        }
+    }
+
+    pendingCount = count;
+    pendingOverflow = overflow;
+    pendingFailed = (status != OK);
+    pendingDone = true;
+    scanInFlight = false;
+}
+
+ScanEngine::ScanEngine() :
+    state(IDLE),
+    passive(false),
+    dwellTime(SCAN_ACTIVE_DWELL_MS),
+    channelMask(SCAN_ALL_CHANNELS),
+    currentChannel(WIFI_MIN_CHANNEL),
+    channelsDone(0),
+    channelsTotal(0),
+    resultCount(0),
+    overflowCount(0),
+    sweepStartTime(0),
+    sweepEndTime(0),
+    channelStartTime(0),
+    abandonTime(0),
+    resultHandler(nullptr),
+    resultContext(nullptr)
+{
+    memset(channelApCount, 0, sizeof(channelApCount));
+    memset(quietSweeps, 0, sizeof(quietSweeps));
+}
+
+void ScanEngine::setResultHandler(ScanResultHandler handler, void* context) {
+    resultHandler = handler;
+    resultContext = context;
+}
+
+void ScanEngine::setPassive(bool enabled) {
+    passive = enabled;
+}
+
+void ScanEngine::setDwellTime(uint16_t ms) {
+    dwellTime = constrain(ms, SCAN_MIN_DWELL_MS, SCAN_MAX_DWELL_MS);
+}
+
+bool ScanEngine::isPassive() const {
+    return passive;
+}
+
+uint16_t ScanEngine::getDwellTime() const {
+    return dwellTime;
+}
+
+void ScanEngine::start() {
+    start(SCAN_ALL_CHANNELS);
+}
+
+// Begin a new sweep over the channels in the mask, lowest first
+void ScanEngine::start(uint16_t mask) {
+    mask &= SCAN_ALL_CHANNELS;
+    if (mask == 0) {
+        return;
+    }
+
+    channelMask = mask;
+    channelsDone = 0;
+    channelsTotal = 0;
+    for (uint8_t ch = WIFI_MIN_CHANNEL; ch <= WIFI_MAX_CHANNEL; ch++) {
+        if (mask & SCAN_CHANNEL_BIT(ch)) channelsTotal++;
+    }
+
+    currentChannel = WIFI_MIN_CHANNEL;
+    while (!(mask & SCAN_CHANNEL_BIT(currentChannel))) {
+        currentChannel++;
+    }
+
+    resultCount = 0;
+    sweepStartTime = millis();
+    sweepEndTime = 0;
+    state = START_CHANNEL;
+}
+
+// Sweep the channels that had APs last time, and bring each quiet channel
+// in only every SCAN_QUIET_CHANNEL_INTERVAL sweeps
+void ScanEngine::startAdaptive() {
+    uint16_t mask = 0;
+    for (uint8_t ch = WIFI_MIN_CHANNEL; ch <= WIFI_MAX_CHANNEL; ch++) {
+        if (channelApCount[ch] > 0 || ++quietSweeps[ch] >= SCAN_QUIET_CHANNEL_INTERVAL) {
+            mask |= SCAN_CHANNEL_BIT(ch);
+            quietSweeps[ch] = 0;
+        }
+    }
+    start(mask ? mask : SCAN_ALL_CHANNELS);
+}
+
+void ScanEngine::scanChannel(uint8_t channel) {
+    if (channel >= WIFI_MIN_CHANNEL && channel <= WIFI_MAX_CHANNEL) {
+        start(SCAN_CHANNEL_BIT(channel));
+    }
+}
+
+void ScanEngine::cancel() {
+    if (state == IDLE || state == DONE) {
+        return;
+    }
+    abandon();
+    state = IDLE;
+    sweepEndTime = millis();
+}
+
+// Stop waiting for the running SDK scan. It may still report; startChannel()
+// holds the next request back until it has, or SCAN_STALE_GRACE_MS passed.
+void ScanEngine::abandon() {
+    scanInFlight = false;
+    abandonTime = millis();
+}
+
+bool ScanEngine::update() {
+    switch (state) {
+        case START_CHANNEL:
+            if (scansReported != scansIssued) {
+                // An abandoned scan is still running - the SDK would refuse
+                // a new one, or run it and report the old one first
+                if (millis() - abandonTime < SCAN_STALE_GRACE_MS) {
+                    return false;
+                }
+                scansReported = scansIssued;  // Lost - never reported
+            }
+            if (startChannel()) {
+                state = SCANNING;
+            } else {
+                Serial.print(F("Scan failed to start on channel "));
+                Serial.println(currentChannel);
+                finishChannel();
+            }
+            return false;
+
+        case SCANNING: {
+            bool delivered = false;
+
+            if (pendingDone) {
+                uint8_t seen = pendingFailed ? 0 : pendingCount;
+                channelApCount[currentChannel] = seen;
+                overflowCount += pendingOverflow;
+                delivered = deliverResults() > 0;
+            } else if (millis() - channelStartTime < (unsigned long)(dwellTime + SCAN_CHANNEL_TIMEOUT_MS)) {
+                // Still listening - only give up if the SDK never reports back
+                return false;
+            } else {
+                abandon();
+            }
+
+            finishChannel();
+            return delivered;
+        }
+
+        case IDLE:
+        case DONE:
+        default:
+            return false;
+    }
+}
+
+// Kick off an SDK scan restricted to the current channel
+bool ScanEngine::startChannel() {
+    if (!(wifi_get_opmode() & STATION_MODE)) {
+        wifi_set_opmode_current(STATION_MODE);
+    }
+
+    struct scan_config config;
+    memset(&config, 0, sizeof(config));
+    config.channel = currentChannel;
+    config.show_hidden = 1;
+    if (passive) {
+        config.scan_type = WIFI_SCAN_TYPE_PASSIVE;
+        config.scan_time.passive = dwellTime;
+    } else {
+        config.scan_type = WIFI_SCAN_TYPE_ACTIVE;
+        config.scan_time.active.min = 0;
+        config.scan_time.active.max = dwellTime;
+    }
+
+    pendingDone = false;
+    pendingFailed = false;
+    pendingCount = 0;
+    pendingOverflow = 0;
+    channelStartTime = millis();
+
+    // Numbered before the call in case the SDK reports from inside it
+    scansIssued++;
+    scanInFlight = true;
+    if (!wifi_station_scan(&config, onSdkScanDone)) {
+        scansIssued--;
+        scanInFlight = false;
+    }
+    return scanInFlight;
+}
+
+// Step to the next channel in the mask, or end the sweep
+void ScanEngine::finishChannel() {
+    channelsDone++;
+    if (!nextChannel()) {
+        state = DONE;
+        sweepEndTime = millis();
+    } else {
+        state = START_CHANNEL;
+    }
+}
+
+bool ScanEngine::nextChannel() {
+    for (uint8_t ch = currentChannel + 1; ch <= WIFI_MAX_CHANNEL; ch++) {
+        if (channelMask & SCAN_CHANNEL_BIT(ch)) {
+            currentChannel = ch;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Hand every buffered result of the finished channel to the handler
+int ScanEngine::deliverResults() {
+    int count = pendingCount;
+    pendingDone = false;
+
+    if (!resultHandler) {
+        return 0;
+    }
+
+    for (int i = 0; i < count; i++) {
+        resultHandler(pendingResults[i], resultContext);
+        resultCount++;
+    }
+    return count;
+}
+
+bool ScanEngine::isRunning() const {
+    return state == START_CHANNEL || state == SCANNING;
+}
+
+ScanEngine::State ScanEngine::getState() const {
+    return state;
+}
+
+uint8_t ScanEngine::getCurrentChannel() const {
+    return currentChannel;
+}
+
+int ScanEngine::getProgress() const {
+    if (channelsTotal == 0) {
+        return 0;
+    }
+    return (channelsDone * 100) / channelsTotal;
+}
+
+int ScanEngine::getChannelsDone() const {
+    return channelsDone;
+}
+
+int ScanEngine::getChannelsTotal() const {
+    return channelsTotal;
+}
+
+int ScanEngine::getResultCount() const {
+    return resultCount;
+}
+
+unsigned long ScanEngine::getOverflowCount() const {
+    return overflowCount;
+}
+
+unsigned long ScanEngine::getDuration() const {
+    if (isRunning()) {
+        return millis() - sweepStartTime;
+    }
+    return sweepEndTime - sweepStartTime;
+}
+
+uint8_t ScanEngine::getChannelApCount(uint8_t channel) const {
+    if (channel > WIFI_MAX_CHANNEL) {
+        return 0;
+    }
+    return channelApCount[channel];
+}
@@ -0,0 +1,96 @@
+#ifndef SCAN_ENGINE_H
+#define SCAN_ENGINE_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// One access point as reported by a single channel sweep
+struct ScanResult {
+    uint8_t bssid[6];
+    char ssid[33];
+    int8_t rssi;
+    uint8_t channel;
+    uint8_t encType;   // ENC_TYPE_* value from ESP8266WiFi
+    bool isHidden;
+};
+
+typedef void (*ScanResultHandler)(const ScanResult& result, void* context);
+
+// Bit n of a channel mask selects channel n
+#define SCAN_CHANNEL_BIT(ch) ((uint16_t)1 << (ch))
+#define SCAN_ALL_CHANNELS    ((uint16_t)(((1u << (WIFI_MAX_CHANNEL + 1)) - 1) & ~((1u << WIFI_MIN_CHANNEL) - 1)))
+
+// Non-blocking scan scheduler. Each channel in the mask is scanned on its
+// own with an SDK scan using the configured probe type and dwell time, and
+// results are handed to the handler as soon as that channel completes, so
+// callers never wait on a full sweep.
+class ScanEngine {
+public:
+    enum State {
+        IDLE,
+        START_CHANNEL,
+        SCANNING,
+        DONE
+    };
+
+    ScanEngine();
+
+    void setResultHandler(ScanResultHandler handler, void* context);
+
+    // Probe settings, applied from the next channel scanned
+    void setPassive(bool passive);
+    void setDwellTime(uint16_t ms);
+    bool isPassive() const;
+    uint16_t getDwellTime() const;
+
+    void start();                        // Every channel
+    void start(uint16_t channelMask);    // Only the channels in the mask
+    void startAdaptive();                // Busy channels now, quiet ones every few sweeps
+    void scanChannel(uint8_t channel);   // Quick re-check of one channel
+    void cancel();
+
+    // Advance the state machine - call from every loop iteration.
+    // Returns true when new results were delivered to the handler.
+    bool update();
+
+    bool isRunning() const;
+    State getState() const;
+    uint8_t getCurrentChannel() const;
+    int getProgress() const;           // 0-100, by channels completed
+    int getChannelsDone() const;
+    int getChannelsTotal() const;
+    int getResultCount() const;        // Results delivered in this sweep
+    unsigned long getOverflowCount() const;  // APs lost to a full SCAN_RESULT_BUFFER, ever
+    unsigned long getDuration() const; // ms, of the running or last sweep
+    uint8_t getChannelApCount(uint8_t channel) const;  // APs seen on its last scan
+
+private:
+    bool startChannel();
+    void abandon();
+    bool nextChannel();
+    void finishChannel();
+    int deliverResults();
+
+    State state;
+    bool passive;
+    uint16_t dwellTime;
+    uint16_t channelMask;
+    uint8_t currentChannel;
+    uint8_t channelsDone;
+    uint8_t channelsTotal;
+    int resultCount;
+    unsigned long overflowCount;
+    unsigned long sweepStartTime;
+    unsigned long sweepEndTime;
+    unsigned long channelStartTime;
+    unsigned long abandonTime;         // Last SDK scan given up on
+
+    // Per-channel history used by startAdaptive()
+    uint8_t channelApCount[WIFI_MAX_CHANNEL + 1];
+    uint8_t quietSweeps[WIFI_MAX_CHANNEL + 1];
+
+    ScanResultHandler resultHandler;
+    void* resultContext;
+};
+
+#endif
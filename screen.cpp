@@ -0,0 +1,135 @@
+#include "screen.h"
+#include "main_menu.h"
+
+ScreenStack screens;
+MessageScreen messageScreen;
+
+// ===== Screen stack =====
+
+ScreenStack::ScreenStack() :
+    depth(0)
+{
+}
+
+bool ScreenStack::push(Screen* screen) {
+    if (depth == SCREEN_STACK_DEPTH || contains(screen)) {
+        Serial.println(F("Screen stack: push refused"));
+        return false;
+    }
+    stack[depth++] = screen;
+    screen->frame.invalidate();
+    screen->onEnter();
+    return true;
+}
+
+// The screen below is told which one closed, so it can pick up a result
+void ScreenStack::pop() {
+    if (depth == 0) {
+        return;
+    }
+    Screen* closed = stack[--depth];
+    closed->onExit();
+    if (depth > 0) {
+        stack[depth - 1]->frame.invalidate();
+        stack[depth - 1]->onResume(closed);
+    }
+}
+
+// Every screen gets onExit(), but none is resumed - whatever a closing
+// dialog would have reported back is dropped with it
+void ScreenStack::clear() {
+    while (depth > 0) {
+        stack[--depth]->onExit();
+    }
+}
+
+Screen* ScreenStack::top() const {
+    return depth > 0 ? stack[depth - 1] : nullptr;
+}
+
+bool ScreenStack::contains(const Screen* screen) const {
+    for (uint8_t i = 0; i < depth; i++) {
+        if (stack[i] == screen) return true;
+    }
+    return false;
+}
+
+void ScreenStack::run(Button btn) {
+    Screen* screen = top();
+    if (!screen) {
+        return;
+    }
+    screen->update(btn);
+
+    // update() may have pushed or popped - draw whatever is on top now
+    screen = top();
+    if (screen && screen->frame.shouldDraw()) {
+        display.clearDisplay();
+        screen->render();
+        display.display();
+    }
+}
+
+// ===== Timed message =====
+
+MessageScreen::MessageScreen() :
+    duration(0),
+    openTime(0),
+    x(0),
+    y(0)
+{
+    text[0] = '\0';
+}
+
+void MessageScreen::open(const char* message, unsigned long durationMs, int textX, int textY) {
+    strncpy(text, message, sizeof(text) - 1);
+    text[sizeof(text) - 1] = '\0';
+    duration = durationMs;
+    x = textX;
+    y = textY;
+
+    if (screens.top() == this) {
+        onEnter();  // Replace the message already showing
+        invalidate();
+    } else {
+        screens.push(this);
+    }
+}
+
+void MessageScreen::open(const __FlashStringHelper* message, unsigned long durationMs, int textX, int textY) {
+    char buffer[sizeof(text)];
+    strncpy_P(buffer, (PGM_P)message, sizeof(buffer) - 1);
+    buffer[sizeof(buffer) - 1] = '\0';
+    open(buffer, durationMs, textX, textY);
+}
+
+void MessageScreen::onEnter() {
+    openTime = millis();
+}
+
+// Buttons are swallowed until the message has been up for its full time
+void MessageScreen::update(Button btn) {
+    if (millis() - openTime >= duration) {
+        screens.pop();
+    }
+}
+
+void MessageScreen::render() {
+    int lineCount = 1;
+    for (const char* p = text; *p; p++) {
+        if (*p == '\n') lineCount++;
+    }
+
+    display.setTextColor(SSD1306_WHITE);
+    int lineY = y >= 0 ? y : (SCREEN_HEIGHT - lineCount * 10 + 2) / 2;
+    const char* line = text;
+    while (true) {
+        const char* end = strchr(line, '\n');
+        int len = end ? end - line : strlen(line);
+        display.setCursor(x >= 0 ? x : (SCREEN_WIDTH - len * 6) / 2, lineY);
+        display.write(line, len);
+        if (!end) break;
+        line = end + 1;
+        lineY += 10;
+    }
+}
@@ -0,0 +1,77 @@
+#ifndef SCREEN_H
+#define SCREEN_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "ButtonManager.h"
+#include "frame_pacer.h"
+
+// One full-screen UI state. loop() hands the top screen of the stack the
+// latest button every pass and lets it render when its frame is dirty, so
+// nothing blocks and background work keeps running under every screen.
+class Screen {
+public:
+    virtual ~Screen() {}
+
+    virtual void update(Button btn) = 0;      // Input and state, once per loop pass
+    virtual void render() = 0;                // Draw into the cleared frame buffer
+
+    virtual void onEnter() {}                 // Pushed onto the stack
+    virtual void onExit() {}                  // Popped off it
+    virtual void onResume(Screen* closed) {}  // The screen above this one closed
+
+    void invalidate() { frame.invalidate(); }
+
+protected:
+    FramePacer frame;
+
+    friend class ScreenStack;
+};
+
+// Screens are long-lived objects owned by the menus; the stack only
+// holds pointers, so pushing and popping never allocates
+class ScreenStack {
+public:
+    ScreenStack();
+
+    bool push(Screen* screen);
+    void pop();                               // Close the top screen
+    void clear();                             // Close all, nothing resumes
+    Screen* top() const;
+    bool contains(const Screen* screen) const;
+    bool isActive() const { return depth > 0; }
+
+    void run(Button btn);                     // Update, then render if due
+
+private:
+    Screen* stack[SCREEN_STACK_DEPTH];
+    uint8_t depth;
+};
+
+extern ScreenStack screens;
+
+// A few lines of text that close themselves after a while - stands in for
+// the old "draw, then wait" confirmation messages
+class MessageScreen : public Screen {
+public:
+    MessageScreen();
+
+    // x or y below 0 centers the text on that axis
+    void open(const char* text, unsigned long durationMs, int x = 0, int y = 0);
+    void open(const __FlashStringHelper* text, unsigned long durationMs, int x = 0, int y = 0);
+
+    void update(Button btn) override;
+    void render() override;
+    void onEnter() override;
+
+private:
+    char text[64];            // Lines separated by '\n'
+    unsigned long duration;
+    unsigned long openTime;
+    int16_t x;
+    int16_t y;
+};
+
+extern MessageScreen messageScreen;
+
+#endif
@@ -0,0 +1,100 @@
+#include "shadow_display.h"
+
+ShadowedSSD1306::ShadowedSSD1306(uint8_t w, uint8_t h, TwoWire* twi, int8_t rstPin) :
+    Adafruit_SSD1306(w, h, twi, rstPin),
+    shadow(nullptr),
+    shadowValid(false),
+    frames(0),
+    skipped(0),
+    bytesSent(0)
+{
+}
+
+ShadowedSSD1306::~ShadowedSSD1306() {
+    delete[] shadow;
+}
+
+bool ShadowedSSD1306::begin(uint8_t switchvcc, uint8_t addr, bool reset, bool periphBegin) {
+    if (!Adafruit_SSD1306::begin(switchvcc, addr, reset, periphBegin)) {
+        return false;
+    }
+    if (!shadow) {
+        shadow = new uint8_t[WIDTH * ((HEIGHT + 7) / 8)];
+        if (!shadow) {
+            Serial.println(F("Display shadow allocation failed"));
+            return false;
+        }
+    }
+    shadowValid = false;  // Panel RAM content is unknown after init
+    return true;
+}
+
+void ShadowedSSD1306::invalidate() {
+    shadowValid = false;
+}
+
+void ShadowedSSD1306::display() {
+    if (!shadow) {
+        Adafruit_SSD1306::display();
+        return;
+    }
+
+    frames++;
+    bool sent = false;
+    uint8_t pages = (HEIGHT + 7) / 8;
+    wire->setClock(wireClk);
+
+    for (uint8_t page = 0; page < pages; page++) {
+        const uint8_t* now = buffer + page * WIDTH;
+        const uint8_t* was = shadow + page * WIDTH;
+
+        int first = 0;
+        int last = WIDTH - 1;
+        if (shadowValid) {
+            while (first < WIDTH && now[first] == was[first]) first++;
+            if (first == WIDTH) {
+                continue;  // Page unchanged
+            }
+            while (now[last] == was[last]) last--;
+        }
+
+        sendSpan(page, first, last);
+        sent = true;
+    }
+
+    wire->setClock(restoreClk);
+
+    if (sent) {
+        memcpy(shadow, buffer, WIDTH * pages);
+        shadowValid = true;
+    } else {
+        skipped++;
+    }
+}
+
+// Point the panel's address window at one page strip and stream it
+void ShadowedSSD1306::sendSpan(uint8_t page, uint8_t firstCol, uint8_t lastCol) {
+    uint8_t window[] = { SSD1306_PAGEADDR, page, page, SSD1306_COLUMNADDR, firstCol, lastCol };
+    wire->beginTransmission(i2caddr);
+    wire->write((uint8_t)0x00);  // Command stream
+    wire->write(window, sizeof(window));
+    wire->endTransmission();
+
+    const uint8_t* ptr = buffer + page * WIDTH + firstCol;
+    uint16_t count = lastCol - firstCol + 1;
+    wire->beginTransmission(i2caddr);
+    wire->write((uint8_t)0x40);  // Data stream
+    uint16_t bytesOut = 1;
+    while (count--) {
+        if (bytesOut >= BUFFER_LENGTH) {
+            wire->endTransmission();
+            wire->beginTransmission(i2caddr);
+            wire->write((uint8_t)0x40);
+            bytesOut = 1;
+        }
+        wire->write(*ptr++);
+        bytesOut++;
+        bytesSent++;
+    }
+    wire->endTransmission();
+}
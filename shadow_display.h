@@ -0,0 +1,38 @@
+#ifndef SHADOW_DISPLAY_H
+#define SHADOW_DISPLAY_H
+
+#include <Arduino.h>
+#include <Wire.h>
+#include <Adafruit_SSD1306.h>
+
+// SSD1306 that remembers what the panel is showing. display() compares the
+// framebuffer with that shadow copy and, for each 8-row page that changed,
+// sends only the columns from the first to the last changed byte. An
+// unchanged frame costs no I2C traffic at all; moving a selection bar or a
+// marquee costs one or two page strips instead of the whole 1 KB.
+class ShadowedSSD1306 : public Adafruit_SSD1306 {
+public:
+    ShadowedSSD1306(uint8_t w, uint8_t h, TwoWire* twi = &Wire, int8_t rstPin = -1);
+    ~ShadowedSSD1306();
+
+    bool begin(uint8_t switchvcc = SSD1306_SWITCHCAPVCC, uint8_t i2caddr = 0,
+               bool reset = true, bool periphBegin = true);
+
+    void display();      // Hides Adafruit_SSD1306::display()
+    void invalidate();   // Resend everything on the next display()
+
+    unsigned long getFrameCount() const { return frames; }
+    unsigned long getSkippedFrames() const { return skipped; }   // Nothing had changed
+    unsigned long getBytesSent() const { return bytesSent; }     // Pixel data only
+
+private:
+    void sendSpan(uint8_t page, uint8_t firstCol, uint8_t lastCol);
+
+    uint8_t* shadow;
+    bool shadowValid;
+    unsigned long frames;
+    unsigned long skipped;
+    unsigned long bytesSent;
+};
+
+#endif
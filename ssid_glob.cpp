@@ -0,0 +1,161 @@
+#include "ssid_glob.h"
+
+static inline char lowerAscii(char c) {
+    return (c >= 'A' && c <= 'Z') ? c + ('a' - 'A') : c;
+}
+
+// Case-insensitive compare of n bytes
+static bool equalsLower(const char* text, const char* lower, uint8_t n) {
+    for (uint8_t i = 0; i < n; i++) {
+        if (lowerAscii(text[i]) != lower[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+SsidGlob::SsidGlob() :
+    mode(MATCH_ALL),
+    literalLen(0),
+    tokenCount(0),
+    anyMask(0),
+    starMask(0),
+    charCount(0)
+{
+    literal[0] = '\0';
+}
+
+bool SsidGlob::compile(const char* pattern) {
+    mode = MATCH_ALL;
+    literalLen = 0;
+    tokenCount = 0;
+    anyMask = 0;
+    starMask = 0;
+    charCount = 0;
+
+    size_t patternLen = strlen(pattern);
+    if (patternLen == 0) {
+        return true;
+    }
+    if (patternLen > SSID_GLOB_MAX_LEN) {
+        return false;
+    }
+
+    // Tokenize, folding runs of '*' into one
+    char tokens[SSID_GLOB_MAX_LEN];
+    bool hasWildcard = false;
+    for (size_t i = 0; i < patternLen; i++) {
+        char c = lowerAscii(pattern[i]);
+        if (c == '*' && tokenCount > 0 && tokens[tokenCount - 1] == '*') {
+            continue;
+        }
+        if (c == '*' || c == '?') {
+            hasWildcard = true;
+        }
+        tokens[tokenCount++] = c;
+    }
+
+    // Fast paths: a single literal run with at most a '*' on either end
+    uint8_t start = 0;
+    uint8_t end = tokenCount;
+    bool leadingStar = tokens[0] == '*';
+    bool trailingStar = tokenCount > 1 && tokens[tokenCount - 1] == '*';
+    if (leadingStar) start++;
+    if (trailingStar) end--;
+
+    bool plainRun = true;
+    for (uint8_t i = start; i < end; i++) {
+        if (tokens[i] == '*' || tokens[i] == '?') {
+            plainRun = false;
+            break;
+        }
+    }
+
+    if (plainRun) {
+        literalLen = end - start;
+        memcpy(literal, tokens + start, literalLen);
+        literal[literalLen] = '\0';
+
+        if (literalLen == 0) {
+            mode = MATCH_ALL;           // "*"
+        } else if (!hasWildcard || (leadingStar && trailingStar)) {
+            mode = MATCH_CONTAINS;      // "abc", "*abc*"
+        } else if (leadingStar) {
+            mode = MATCH_SUFFIX;        // "*abc"
+        } else {
+            mode = MATCH_PREFIX;        // "abc*"
+        }
+        return true;
+    }
+
+    // General case: build the per-character transition masks
+    for (uint8_t i = 0; i < tokenCount; i++) {
+        uint64_t bit = (uint64_t)1 << i;
+        char c = tokens[i];
+        if (c == '*') {
+            starMask |= bit;
+        } else if (c == '?') {
+            anyMask |= bit;
+        } else {
+            uint8_t slot = 0;
+            while (slot < charCount && chars[slot] != c) slot++;
+            if (slot == charCount) {
+                chars[charCount] = c;
+                charMasks[charCount] = 0;
+                charCount++;
+            }
+            charMasks[slot] |= bit;
+        }
+    }
+    mode = MATCH_NFA;
+    return true;
+}
+
+uint64_t SsidGlob::charMask(char c) const {
+    for (uint8_t i = 0; i < charCount; i++) {
+        if (chars[i] == c) {
+            return charMasks[i];
+        }
+    }
+    return 0;
+}
+
+// One pass over the SSID, all pattern positions tracked at once. A '*'
+// token keeps its bit on every character and also lets the next token
+// start without consuming anything.
+bool SsidGlob::matchNfa(const char* ssid, uint8_t len) const {
+    uint64_t state = 1;
+    state |= (state & starMask) << 1;
+
+    for (uint8_t i = 0; i < len && state; i++) {
+        uint64_t step = charMask(lowerAscii(ssid[i])) | anyMask;
+        state = ((state & step) << 1) | (state & starMask);
+        state |= (state & starMask) << 1;
+    }
+    return (state >> tokenCount) & 1;
+}
+
+bool SsidGlob::matches(const char* ssid, uint8_t len) const {
+    switch (mode) {
+        case MATCH_ALL:
+            return true;
+
+        case MATCH_PREFIX:
+            return len >= literalLen && equalsLower(ssid, literal, literalLen);
+
+        case MATCH_SUFFIX:
+            return len >= literalLen && equalsLower(ssid + len - literalLen, literal, literalLen);
+
+        case MATCH_CONTAINS:
+            for (int i = 0; i + literalLen <= len; i++) {
+                if (lowerAscii(ssid[i]) == literal[0] && equalsLower(ssid + i, literal, literalLen)) {
+                    return true;
+                }
+            }
+            return false;
+
+        case MATCH_NFA:
+        default:
+            return matchNfa(ssid, len);
+    }
+}
@@ -0,0 +1,48 @@
+#ifndef SSID_GLOB_H
+#define SSID_GLOB_H
+
+#include <Arduino.h>
+
+#define SSID_GLOB_MAX_LEN 32
+
+// SSID filter pattern compiled once, then matched against raw SSID bytes
+// without allocating or backtracking. Case-insensitive.
+//   - no wildcards: the SSID must contain the text (the old behaviour)
+//   - '*' any run of characters, '?' any single character; the pattern
+//     must then cover the whole SSID
+// Common shapes ("abc*", "*abc", "*abc*") use plain string compares; the
+// rest run as a bit-parallel NFA with one state bit per pattern token.
+class SsidGlob {
+public:
+    SsidGlob();
+
+    bool compile(const char* pattern);  // false if longer than SSID_GLOB_MAX_LEN
+    bool matches(const char* ssid, uint8_t len) const;
+    bool isEmpty() const { return mode == MATCH_ALL; }
+
+private:
+    enum Mode : uint8_t {
+        MATCH_ALL,
+        MATCH_PREFIX,
+        MATCH_SUFFIX,
+        MATCH_CONTAINS,
+        MATCH_NFA
+    };
+
+    bool matchNfa(const char* ssid, uint8_t len) const;
+    uint64_t charMask(char c) const;
+
+    Mode mode;
+    char literal[SSID_GLOB_MAX_LEN + 1];  // Lower-cased text for the fast paths
+    uint8_t literalLen;
+
+    // NFA: bit i set = the first i tokens have matched
+    uint8_t tokenCount;
+    uint64_t anyMask;     // Tokens that are '?'
+    uint64_t starMask;    // Tokens that are '*'
+    uint8_t charCount;
+    char chars[SSID_GLOB_MAX_LEN];        // Distinct literal characters...
+    uint64_t charMasks[SSID_GLOB_MAX_LEN]; // ...and the tokens each one matches
+};
+
+#endif
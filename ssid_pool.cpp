@@ -0,0 +1,186 @@
+#include "ssid_pool.h"
+
+SsidPool::SsidPool() :
+    slots(nullptr),
+    buckets(nullptr),
+    text(nullptr),
+    slotCount(0),
+    bucketMask(0),
+    freeHead(SSID_NONE),
+    distinct(0),
+    textCapacity(0),
+    textUsed(0),
+    deadBytes(0)
+{
+}
+
+// Power of two, at least one bucket per slot
+int SsidPool::bucketCountFor(int count) {
+    int buckets = 1;
+    while (buckets < count) {
+        buckets <<= 1;
+    }
+    return buckets;
+}
+
+bool SsidPool::begin(ScanArena& arena, int count, size_t textBytes) {
+    textBytes = min(textBytes, (size_t)0xFFFF);
+    slots = (Slot*)arena.alloc(count * sizeof(Slot));
+    buckets = (uint16_t*)arena.alloc(bucketCountFor(count) * sizeof(uint16_t));
+    text = (char*)arena.alloc(textBytes);
+    if (!slots || !buckets || !text) {
+        Serial.println(F("SSID pool allocation failed"));
+        slotCount = 0;
+        textCapacity = 0;
+        return false;
+    }
+    slotCount = count;
+    bucketMask = bucketCountFor(count) - 1;
+    textCapacity = textBytes;
+    clear();
+    return true;
+}
+
+size_t SsidPool::arenaBytes(int count, size_t textBytes) {
+    return ScanArena::footprint(count * sizeof(Slot)) +
+           ScanArena::footprint(bucketCountFor(count) * sizeof(uint16_t)) +
+           ScanArena::footprint(textBytes);
+}
+
+void SsidPool::clear() {
+    for (int i = 0; i < slotCount; i++) {
+        slots[i].refs = 0;
+        slots[i].next = (i + 1 < slotCount) ? i + 1 : SSID_NONE;
+    }
+    for (int i = 0; i <= bucketMask && buckets; i++) {
+        buckets[i] = SSID_NONE;
+    }
+    freeHead = slotCount > 0 ? 0 : SSID_NONE;
+    distinct = 0;
+    textUsed = 0;
+    deadBytes = 0;
+}
+
+// FNV-1a folded to 16 bits - only used to skip most memcmp()s
+uint16_t SsidPool::hashOf(const char* str, uint8_t len) {
+    uint32_t hash = 2166136261u;
+    for (uint8_t i = 0; i < len; i++) {
+        hash = (hash ^ (uint8_t)str[i]) * 16777619u;
+    }
+    return (uint16_t)(hash ^ (hash >> 16));
+}
+
+uint16_t SsidPool::intern(const char* str, uint8_t len) {
+    if (len > SSID_MAX_LEN) {
+        len = SSID_MAX_LEN;
+    }
+
+    uint16_t hash = hashOf(str, len);
+    uint16_t& head = buckets[hash & bucketMask];
+    for (uint16_t id = head; id != SSID_NONE; id = slots[id].next) {
+        Slot& slot = slots[id];
+        if (slot.hash == hash && slot.len == len && memcmp(text + slot.offset, str, len) == 0) {
+            if (slot.refs < 0xFFFF) slot.refs++;
+            return id;
+        }
+    }
+
+    if (freeHead == SSID_NONE || !reserve(len + 1)) {
+        return SSID_NONE;
+    }
+
+    uint16_t id = freeHead;
+    Slot& slot = slots[id];
+    freeHead = slot.next;
+    slot.offset = textUsed;
+    slot.len = len;
+    slot.hash = hash;
+    slot.refs = 1;
+    slot.next = head;
+    head = id;
+    memcpy(text + textUsed, str, len);
+    text[textUsed + len] = '\0';
+    textUsed += len + 1;
+    distinct++;
+    return id;
+}
+
+void SsidPool::release(uint16_t id) {
+    if (id >= slotCount || slots[id].refs == 0) {
+        return;
+    }
+    Slot& slot = slots[id];
+    if (--slot.refs > 0) {
+        return;
+    }
+
+    // Unlink from its bucket and put it on the free list
+    uint16_t* link = &buckets[slot.hash & bucketMask];
+    while (*link != id) {
+        link = &slots[*link].next;
+    }
+    *link = slot.next;
+    slot.next = freeHead;
+    freeHead = id;
+
+    deadBytes += slot.len + 1;
+    distinct--;
+}
+
+const char* SsidPool::get(uint16_t id) const {
+    if (id >= slotCount || slots[id].refs == 0) {
+        return "";
+    }
+    return text + slots[id].offset;
+}
+
+uint8_t SsidPool::length(uint16_t id) const {
+    if (id >= slotCount || slots[id].refs == 0) {
+        return 0;
+    }
+    return slots[id].len;
+}
+
+// Make room for bytes more text, compacting if released strings would free enough
+bool SsidPool::reserve(size_t bytes) {
+    if (textUsed + bytes <= textCapacity) {
+        return true;
+    }
+    if (textUsed - deadBytes + bytes > textCapacity) {
+        return false;
+    }
+    compact();
+    return true;
+}
+
+// Slide live strings down over the released ones, lowest offset first.
+// Quadratic in the slot count, but it only runs when the text space is
+// exhausted, which with interning is rare.
+void SsidPool::compact() {
+    size_t writePos = 0;
+    size_t floor = 0;
+
+    for (;;) {
+        int next = -1;
+        for (int i = 0; i < slotCount; i++) {
+            if (slots[i].refs > 0 && slots[i].offset >= floor &&
+                (next < 0 || slots[i].offset < slots[next].offset)) {
+                next = i;
+            }
+        }
+        if (next < 0) {
+            break;
+        }
+
+        Slot& slot = slots[next];
+        floor = slot.offset + slot.len + 1;
+        if (slot.offset != writePos) {
+            memmove(text + writePos, text + slot.offset, slot.len + 1);
+            slot.offset = writePos;
+        }
+        writePos += slot.len + 1;
+    }
+
+    textUsed = writePos;
+    deadBytes = 0;
+}
@@ -0,0 +1,62 @@
+#ifndef SSID_POOL_H
+#define SSID_POOL_H
+
+#include <Arduino.h>
+#include "scan_arena.h"
+
+#define SSID_NONE    0xFFFF   // Id of a hidden network's (empty) SSID
+#define SSID_MAX_LEN 32
+
+// Interned, reference-counted SSID strings. Every distinct ESSID is stored
+// once no matter how many BSSIDs broadcast it (mesh nodes, campus
+// networks...); records hold a 2-byte id instead of a 33-byte copy.
+// Lookups go through a chained hash index, and ids stay valid until their
+// last reference is released - compaction moves the text, never the ids.
+class SsidPool {
+public:
+    SsidPool();
+
+    // Carve slotCount entries and textBytes of string storage from the arena
+    bool begin(ScanArena& arena, int slotCount, size_t textBytes);
+    static size_t arenaBytes(int slotCount, size_t textBytes);
+    void clear();
+
+    // Add a reference to text, storing it if it is new. Returns SSID_NONE
+    // when there is no slot or text space left.
+    uint16_t intern(const char* text, uint8_t len);
+    void release(uint16_t id);
+
+    const char* get(uint16_t id) const;   // "" for SSID_NONE
+    uint8_t length(uint16_t id) const;
+
+    int getDistinctCount() const { return distinct; }
+    size_t getTextUsed() const { return textUsed - deadBytes; }
+    size_t getTextCapacity() const { return textCapacity; }
+
+private:
+    struct Slot {
+        uint16_t offset;   // Into text, NUL-terminated
+        uint16_t refs;     // 0 = free slot
+        uint16_t hash;
+        uint16_t next;     // Next slot in the same bucket, or in the free list
+        uint8_t len;
+    };
+
+    static uint16_t hashOf(const char* text, uint8_t len);
+    static int bucketCountFor(int slotCount);
+    bool reserve(size_t bytes);
+    void compact();
+
+    Slot* slots;
+    uint16_t* buckets;   // Head slot of each hash chain, SSID_NONE if empty
+    char* text;
+    int slotCount;
+    int bucketMask;
+    uint16_t freeHead;
+    int distinct;
+    size_t textCapacity;
+    size_t textUsed;     // High-water mark of the bump allocator
+    size_t deadBytes;    // Text of released strings below textUsed
+};
+
+#endif
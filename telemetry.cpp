@@ -0,0 +1,145 @@
+#include "telemetry.h"
+#include "config.h"
+#include "frame_ring.h"
+
+Telemetry telemetry;
+
+void HeapSample::capture() {
+    freeHeap = ESP.getFreeHeap();
+    maxBlock = ESP.getMaxFreeBlockSize();
+    fragmentation = ESP.getHeapFragmentation();
+    freeStack = ESP.getFreeContStack();
+}
+
+Telemetry::Telemetry() :
+    ranSinceReport(0),
+    lastReport(0)
+{
+    // Low-water marks start high so the first sample sets them, whether
+    // or not begin() has run yet
+    memset(ops, 0, sizeof(ops));
+    for (int i = 0; i < TEL_OP_COUNT; i++) {
+        ops[i].minFreeHeap = UINT32_MAX;
+        ops[i].minMaxBlock = UINT32_MAX;
+        ops[i].minFreeStack = UINT32_MAX;
+    }
+    memset(&boot, 0, sizeof(boot));
+    lowWater = boot;
+    lowWater.freeHeap = UINT32_MAX;
+    lowWater.maxBlock = UINT32_MAX;
+    lowWater.freeStack = UINT32_MAX;
+}
+
+void Telemetry::begin() {
+    boot = sample();
+    lastReport = millis();
+
+    Serial.println(F("# TEL,ms,free,max_block,frag,stack,min_free,min_block,max_frag,min_stack"));
+    Serial.println(F("# TELOP,ms,op,calls,entry_free,exit_free,worst_loss,min_free,min_block,max_frag,min_stack"));
+    Serial.println(F("# TELRX,ms,frames,dropped,ring_high_water,ring_slots"));
+}
+
+const __FlashStringHelper* Telemetry::opName(uint8_t op) {
+    switch (op) {
+        case TEL_OP_SCAN:         return F("scan");
+        case TEL_OP_NETWORK_LIST: return F("list");
+        case TEL_OP_FILTER:       return F("filter");
+        case TEL_OP_DETAILS:      return F("details");
+        case TEL_OP_SAVE_NETWORK: return F("save");
+        case TEL_OP_JOURNAL:      return F("journal");
+        case TEL_OP_SAVED_LIST:   return F("saved_list");
+        default:                  return F("?");
+    }
+}
+
+HeapSample Telemetry::sample() {
+    HeapSample current;
+    current.capture();
+    track(current);
+    return current;
+}
+
+void Telemetry::track(const HeapSample& current) {
+    if (current.freeHeap < lowWater.freeHeap) lowWater.freeHeap = current.freeHeap;
+    if (current.maxBlock < lowWater.maxBlock) lowWater.maxBlock = current.maxBlock;
+    if (current.freeStack < lowWater.freeStack) lowWater.freeStack = current.freeStack;
+    if (current.fragmentation > lowWater.fragmentation) lowWater.fragmentation = current.fragmentation;
+}
+
+void Telemetry::trackOp(TelemetryOpStats& stats, const HeapSample& current) {
+    if (current.freeHeap < stats.minFreeHeap) stats.minFreeHeap = current.freeHeap;
+    if (current.maxBlock < stats.minMaxBlock) stats.minMaxBlock = current.maxBlock;
+    if (current.freeStack < stats.minFreeStack) stats.minFreeStack = current.freeStack;
+    if (current.fragmentation > stats.maxFragmentation) stats.maxFragmentation = current.fragmentation;
+}
+
+void Telemetry::enter(TelemetryOp op) {
+    TelemetryOpStats& stats = ops[op];
+    stats.entry = sample();
+    trackOp(stats, stats.entry);
+}
+
+void Telemetry::exit(TelemetryOp op) {
+    TelemetryOpStats& stats = ops[op];
+    stats.exit = sample();
+    trackOp(stats, stats.exit);
+    stats.calls++;
+
+    int32_t loss = (int32_t)stats.entry.freeHeap - (int32_t)stats.exit.freeHeap;
+    if (stats.calls == 1 || loss > stats.worstLoss) {
+        stats.worstLoss = loss;
+    }
+    ranSinceReport |= (1 << op);
+}
+
+void Telemetry::update() {
+    if (TELEMETRY_SERIAL_INTERVAL_MS == 0 || millis() - lastReport < TELEMETRY_SERIAL_INTERVAL_MS) {
+        return;
+    }
+    lastReport = millis();
+    printReport();
+}
+
+void Telemetry::printReport() {
+    HeapSample now = sample();
+    unsigned long ms = millis();
+
+    Serial.print(F("TEL,"));
+    Serial.print(ms);                    Serial.print(',');
+    Serial.print(now.freeHeap);          Serial.print(',');
+    Serial.print(now.maxBlock);          Serial.print(',');
+    Serial.print(now.fragmentation);     Serial.print(',');
+    Serial.print(now.freeStack);         Serial.print(',');
+    Serial.print(lowWater.freeHeap);     Serial.print(',');
+    Serial.print(lowWater.maxBlock);     Serial.print(',');
+    Serial.print(lowWater.fragmentation); Serial.print(',');
+    Serial.println(lowWater.freeStack);
+
+    for (int i = 0; i < TEL_OP_COUNT; i++) {
+        if (!(ranSinceReport & (1 << i))) {
+            continue;
+        }
+        const TelemetryOpStats& stats = ops[i];
+        Serial.print(F("TELOP,"));
+        Serial.print(ms);                     Serial.print(',');
+        Serial.print(opName(i));              Serial.print(',');
+        Serial.print(stats.calls);            Serial.print(',');
+        Serial.print(stats.entry.freeHeap);   Serial.print(',');
+        Serial.print(stats.exit.freeHeap);    Serial.print(',');
+        Serial.print(stats.worstLoss);        Serial.print(',');
+        Serial.print(stats.minFreeHeap);      Serial.print(',');
+        Serial.print(stats.minMaxBlock);      Serial.print(',');
+        Serial.print(stats.maxFragmentation); Serial.print(',');
+        Serial.println(stats.minFreeStack);
+    }
+
+    if (frameRing.getPushed() != 0 || frameRing.getDropped() != 0) {
+        Serial.print(F("TELRX,"));
+        Serial.print(ms);                        Serial.print(',');
+        Serial.print(frameRing.getPushed());     Serial.print(',');
+        Serial.print(frameRing.getDropped());    Serial.print(',');
+        Serial.print(frameRing.getHighWater());  Serial.print(',');
+        Serial.println(frameRing.capacity());
+    }
+    ranSinceReport = 0;
+}
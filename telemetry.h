@@ -0,0 +1,92 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <Arduino.h>
+
+// Operations sampled on entry and exit, mostly with a TelemetryScope
+enum TelemetryOp : uint8_t {
+    TEL_OP_SCAN,          // One sweep, from its start to the end pollScan() sees
+    TEL_OP_NETWORK_LIST,  // WifiMenu::showScannedNetworks
+    TEL_OP_FILTER,        // WifiMenu::applyFilters
+    TEL_OP_DETAILS,       // WifiMenu::showNetworkDetails
+    TEL_OP_SAVE_NETWORK,  // SavedNetworks::add
+    TEL_OP_JOURNAL,       // Journal::begin (replay)
+    TEL_OP_SAVED_LIST,    // MainMenu::showSavedNetworks
+    TEL_OP_COUNT
+};
+
+// One reading of the heap and the loop stack
+struct HeapSample {
+    uint32_t freeHeap;
+    uint32_t maxBlock;       // Largest allocatable block
+    uint32_t freeStack;      // Never-used part of the loop() stack
+    uint8_t fragmentation;   // 0-100 %
+
+    void capture();
+};
+
+struct TelemetryOpStats {
+    uint32_t calls;
+    HeapSample entry;        // Latest call
+    HeapSample exit;
+    int32_t worstLoss;       // Largest free heap drop from entry to exit, over all calls
+    uint32_t minFreeHeap;    // Lowest free heap seen at entry or exit
+    uint32_t minMaxBlock;
+    uint32_t minFreeStack;
+    uint8_t maxFragmentation;
+};
+
+// Heap, fragmentation and stack instrumentation. Keeps per-operation
+// entry/exit samples and low-water marks, and streams them as CSV lines
+// on the serial port every TELEMETRY_SERIAL_INTERVAL_MS:
+//   TEL,<ms>,<free>,<max_block>,<frag>,<stack>,<min_free>,<min_block>,<max_frag>,<min_stack>
+//   TELOP,<ms>,<op>,<calls>,<entry_free>,<exit_free>,<worst_loss>,<min_free>,<min_block>,<max_frag>,<min_stack>
+//   TELRX,<ms>,<frames>,<dropped>,<ring_high_water>,<ring_slots>
+// A TELOP line is only sent for operations that ran since the last report,
+// TELRX once the monitor has received something.
+class Telemetry {
+public:
+    Telemetry();
+
+    void begin();
+    void enter(TelemetryOp op);
+    void exit(TelemetryOp op);
+
+    // Call from loops - sends the serial report when it is due
+    void update();
+    void printReport();
+
+    // Sample now and fold it into the low-water marks
+    HeapSample sample();
+
+    const HeapSample& getBootSample() const { return boot; }
+    const HeapSample& getLowWater() const { return lowWater; }   // Min free/block/stack, max frag
+    const TelemetryOpStats& getOpStats(uint8_t op) const { return ops[op]; }
+
+    static const __FlashStringHelper* opName(uint8_t op);
+
+private:
+    void track(const HeapSample& current);
+    static void trackOp(TelemetryOpStats& stats, const HeapSample& current);
+
+    TelemetryOpStats ops[TEL_OP_COUNT];
+    HeapSample boot;
+    HeapSample lowWater;
+    uint16_t ranSinceReport;   // Bit per TelemetryOp
+    unsigned long lastReport;
+};
+
+extern Telemetry telemetry;
+
+// Samples when constructed and again when it goes out of scope, so every
+// return path of the instrumented function is covered
+class TelemetryScope {
+public:
+    explicit TelemetryScope(TelemetryOp op) : op(op) { telemetry.enter(op); }
+    ~TelemetryScope() { telemetry.exit(op); }
+
+private:
+    TelemetryOp op;
+};
+
+#endif
@@ -0,0 +1,140 @@
+#!/usr/bin/env python3
+"""Generate oui_table.h, the flash-resident MAC vendor database.
+
+Input is one or more CSV files in the IEEE registry format
+(Registry,Assignment,Organization Name,...), e.g. the MA-L list from
+https://standards-oui.ieee.org/oui/oui.csv. Only MA-L (24-bit) assignments
+are used. Without arguments the small seed list in tools/oui_seed.csv is
+used, which is what the checked-in table was built from.
+
+    python3 tools/gen_oui.py [--output oui_table.h] [oui.csv ...]
+
+The CMake build generates its own copy in the build tree, from
+tools/oui.csv (or -DOUI_CSV=...) when the registry is there; the
+update_oui target rewrites the checked-in oui_table.h, which the Arduino
+build uses, from the registry. -DOUI_DOWNLOAD=ON fetches the registry
+first. The table is written to stdout without --output; with it, only once
+it is complete.
+
+Layout (all PROGMEM):
+  OUI_PREFIXES   3 bytes per entry, sorted, binary searched on the BSSID
+  OUI_VENDOR     uint16 vendor id per entry
+  OUI_NAME_OFFS  offset of each vendor name in the pool (oui_name_offset_t)
+  OUI_NAME_POOL  NUL-separated, de-duplicated vendor names
+"""
+import csv
+import io
+import os
+import re
+import sys
+
+MAX_NAME = 20  # Longest name the details screen shows without scrolling
+
+# Corporate suffixes dropped to keep the pool (and the screen) short
+SUFFIXES = re.compile(
+    r"[ ,.]+(co|corp|corporation|inc|incorporated|ltd|limited|llc|gmbh|ag|sa|s\.a|"
+    r"bv|b\.v|oy|ab|as|plc|pte|pty|srl|spa|kg|technologies|technology|"
+    r"electronics|communications|international|company|group|holdings)\.?$",
+    re.IGNORECASE)
+
+
+def short_name(name):
+    name = " ".join(name.replace('"', "").split())
+    prev = None
+    while prev != name:
+        prev = name
+        name = SUFFIXES.sub("", name).strip(" ,.")
+    return (name or prev)[:MAX_NAME].rstrip()
+
+
+def load(paths):
+    entries = {}
+    for path in paths:
+        if not os.path.isfile(path):
+            sys.exit("gen_oui: cannot read %s" % path)
+        with open(path, newline="", encoding="utf-8", errors="replace") as f:
+            for row in csv.reader(f):
+                if len(row) < 3 or row[0] != "MA-L":
+                    continue
+                oui = row[1].strip().upper()
+                if not re.fullmatch(r"[0-9A-F]{6}", oui):
+                    continue
+                entries.setdefault(int(oui, 16), short_name(row[2]))
+    return entries
+
+
+def c_string(s):
+    out = []
+    for ch in s:
+        if ch in '"\\':
+            out.append("\\" + ch)
+        elif 32 <= ord(ch) < 127:
+            out.append(ch)
+        else:
+            out.append("?")
+    return "".join(out)
+
+
+def main():
+    here = os.path.dirname(os.path.abspath(__file__))
+    args = sys.argv[1:]
+    output = None
+    if args[:1] == ["--output"]:
+        if len(args) < 2:
+            sys.exit("gen_oui: --output needs a file")
+        output, args = args[1], args[2:]
+    paths = args or [os.path.join(here, "oui_seed.csv")]
+    entries = load(paths)
+    if not entries:
+        sys.exit("gen_oui: no MA-L entries found")
+
+    names = sorted(set(entries.values()))
+    vendor_id = {n: i for i, n in enumerate(names)}
+    offsets, pool = [], 0
+    for n in names:
+        offsets.append(pool)
+        pool += len(n.encode("ascii", "replace")) + 1
+    offs_type = "uint16_t" if pool <= 0xFFFF else "uint32_t"
+    ouis = sorted(entries)
+
+    out = io.StringIO()
+    w = out.write
+    w("// Generated by tools/gen_oui.py from %s - do not edit\n" % ", ".join(os.path.basename(p) for p in paths))
+    w("#ifndef OUI_TABLE_H\n#define OUI_TABLE_H\n\n#include <Arduino.h>\n\n")
+    w("#define OUI_ENTRY_COUNT  %d\n" % len(ouis))
+    w("#define OUI_VENDOR_COUNT %d\n\n" % len(names))
+
+    w("static const uint8_t OUI_PREFIXES[OUI_ENTRY_COUNT * 3] PROGMEM = {\n")
+    for i in range(0, len(ouis), 4):
+        chunk = ouis[i:i + 4]
+        w("    " + " ".join("0x%02X,0x%02X,0x%02X," % (o >> 16, (o >> 8) & 0xFF, o & 0xFF) for o in chunk) + "\n")
+    w("};\n\n")
+
+    w("static const uint16_t OUI_VENDOR[OUI_ENTRY_COUNT] PROGMEM = {\n")
+    for i in range(0, len(ouis), 12):
+        w("    " + " ".join("%d," % vendor_id[entries[o]] for o in ouis[i:i + 12]) + "\n")
+    w("};\n\n")
+
+    w("typedef %s oui_name_offset_t;\n\n" % offs_type)
+    w("static const oui_name_offset_t OUI_NAME_OFFS[OUI_VENDOR_COUNT] PROGMEM = {\n")
+    for i in range(0, len(offsets), 12):
+        w("    " + " ".join("%d," % o for o in offsets[i:i + 12]) + "\n")
+    w("};\n\n")
+
+    w("static const char OUI_NAME_POOL[] PROGMEM =\n")
+    for n in names:
+        w('    "%s\\0"\n' % c_string(n))
+    w("    ;\n\n#endif\n")
+
+    if output is None:
+        sys.stdout.write(out.getvalue())
+        return
+    # A failed run must not leave a half-written table behind
+    tmp = output + ".tmp"
+    with open(tmp, "w", newline="\n") as f:
+        f.write(out.getvalue())
+    os.replace(tmp, output)
+
+
+if __name__ == "__main__":
+    main()
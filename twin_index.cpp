@@ -0,0 +1,264 @@
+#include "twin_index.h"
+#include "saved_networks.h"
+#include "vendor_db.h"
+
+#define TWIN_NONE 0xFFFF   // End of a chain
+
+// Open, WEP and the WPA family; a network never legitimately spans two
+static uint8_t securityClass(uint8_t encType) {
+    switch (encType) {
+        case NET_ENC_OPEN:     return 1;
+        case NET_ENC_WEP:      return 2;
+        case NET_ENC_WPA:
+        case NET_ENC_WPA2:
+        case NET_ENC_WPA_WPA2: return 3;
+        default:               return 0;   // Unknown, never compared
+    }
+}
+
+TwinIndex::TwinIndex() :
+    heads(nullptr),
+    next(nullptr),
+    linked(nullptr),
+    flags(nullptr),
+    capacity(0),
+    ssidSlots(0),
+    entries(0),
+    flagged(0),
+    indexedLayout(0),
+    savedRevision(0),
+    quiet(false)
+{
+}
+
+size_t TwinIndex::arenaBytes(int size, int slots) {
+    return ScanArena::footprint(slots * sizeof(uint16_t)) +
+           ScanArena::footprint(size * sizeof(uint16_t)) * 2 +
+           ScanArena::footprint(size);
+}
+
+bool TwinIndex::begin(ScanArena& arena, int size, int slots) {
+    heads = (uint16_t*)arena.alloc(slots * sizeof(uint16_t));
+    next = (uint16_t*)arena.alloc(size * sizeof(uint16_t));
+    linked = (uint16_t*)arena.alloc(size * sizeof(uint16_t));
+    flags = (uint8_t*)arena.alloc(size);
+    if (!heads || !next || !linked || !flags) {
+        Serial.println(F("Twin index allocation failed"));
+        capacity = 0;
+        ssidSlots = 0;
+        return false;
+    }
+    capacity = size;
+    ssidSlots = slots;
+    entries = 0;
+    flagged = 0;
+    memset(heads, 0xFF, slots * sizeof(uint16_t));
+    indexedLayout = 0;
+    savedRevision = savedNetworks.getRevision();
+    return true;
+}
+
+// ===== Chains =====
+
+void TwinIndex::link(int index, uint16_t ssidId) {
+    linked[index] = ssidId;
+    if (ssidId >= ssidSlots) {
+        next[index] = TWIN_NONE;   // Hidden - not indexed
+        return;
+    }
+    next[index] = heads[ssidId];
+    heads[ssidId] = index;
+}
+
+void TwinIndex::unlink(int index) {
+    uint16_t ssidId = linked[index];
+    if (ssidId >= ssidSlots) {
+        return;
+    }
+    uint16_t* at = &heads[ssidId];
+    while (*at != TWIN_NONE && *at != index) {
+        at = &next[*at];
+    }
+    if (*at == index) {
+        *at = next[index];
+    }
+    linked[index] = SSID_NONE;
+}
+
+// After a layout change the old flags belong to other entries, so they are
+// recomputed silently; after an edit of the saved networks they still line
+// up and whatever the edit newly flags is logged.
+void TwinIndex::rebuild(const NetworkTable& table) {
+    bool moved = table.getLayout() != indexedLayout;
+    int previous = entries;
+    entries = min(table.size(), capacity);
+    if (moved) {
+        memset(flags, 0, entries);
+        flagged = 0;
+    } else {
+        for (int i = previous; i < entries; i++) {
+            flags[i] = 0;
+        }
+    }
+
+    memset(heads, 0xFF, ssidSlots * sizeof(uint16_t));
+    for (int i = entries - 1; i >= 0; i--) {   // Chains come out in table order
+        link(i, table[i].ssidId);
+    }
+
+    quiet = moved;
+    for (int id = 0; id < ssidSlots; id++) {
+        if (heads[id] != TWIN_NONE) {
+            check(table, id);
+        }
+    }
+    quiet = false;
+
+    indexedLayout = table.getLayout();
+    savedRevision = savedNetworks.getRevision();
+}
+
+void TwinIndex::update(const NetworkTable& table, int index) {
+    if (table.getLayout() != indexedLayout || savedNetworks.getRevision() != savedRevision ||
+        index > entries || index >= capacity) {
+        rebuild(table);
+        return;
+    }
+
+    if (index == entries) {   // Appended
+        entries++;
+        linked[index] = SSID_NONE;
+        next[index] = TWIN_NONE;
+        flags[index] = 0;
+    }
+
+    uint16_t ssidId = table[index].ssidId;
+    uint16_t old = linked[index];
+    if (old != ssidId) {
+        // Evicted and replaced, or a hidden AP that gave its name
+        unlink(index);
+        if (old < ssidSlots && heads[old] != TWIN_NONE) {
+            check(table, old);
+        }
+        link(index, ssidId);
+    }
+
+    if (ssidId < ssidSlots) {
+        check(table, ssidId);
+    } else {
+        setFlags(table, index, 0);
+    }
+}
+
+void TwinIndex::sync(const NetworkTable& table) {
+    if (table.getLayout() != indexedLayout || savedNetworks.getRevision() != savedRevision ||
+        table.size() != entries) {
+        rebuild(table);
+    }
+}
+
+// ===== Checks =====
+
+// Re-test every BSSID advertising one SSID against that network's reference
+void TwinIndex::check(const NetworkTable& table, uint16_t ssidId) {
+    const SsidPool& pool = table.getSsidPool();
+    const char* ssid = pool.get(ssidId);
+    uint8_t ssidLen = pool.length(ssidId);
+
+    // Saved networks with this SSID are the allow-list
+    int firstSaved = -1;
+    for (int i = 0; i < savedNetworks.count(); i++) {
+        const SavedNetwork& saved = savedNetworks.get(i);
+        if (saved.ssidLen == ssidLen && memcmp(saved.ssid, ssid, ssidLen) == 0) {
+            firstSaved = i;
+            break;
+        }
+    }
+
+    // Reference entry: a saved BSSID if one is in range, else the earliest seen
+    int reference = -1;
+    for (uint16_t i = heads[ssidId]; i != TWIN_NONE; i = next[i]) {
+        if (firstSaved >= 0 && savedNetworks.contains(table[i].bssid)) {
+            reference = i;
+            break;
+        }
+        if (reference < 0 || table[i].firstSeen < table[reference].firstSeen) {
+            reference = i;
+        }
+    }
+    if (reference < 0) {
+        return;
+    }
+
+    uint8_t expectedClass = securityClass(table[reference].encType);
+    uint16_t expectedVendor = firstSaved >= 0 ? vendorLookup(savedNetworks.get(firstSaved).bssid)
+                                              : table[reference].vendorId;
+
+    for (uint16_t i = heads[ssidId]; i != TWIN_NONE; i = next[i]) {
+        const NetworkRecord& net = table[i];
+        uint8_t result = 0;
+
+        uint8_t netClass = securityClass(net.encType);
+        if (expectedClass && netClass && netClass != expectedClass) {
+            result |= TWIN_SECURITY;
+        }
+        if (expectedVendor != VENDOR_UNKNOWN && net.vendorId != expectedVendor) {
+            result |= TWIN_VENDOR;
+        }
+        if (firstSaved >= 0) {
+            bool channelSaved = false;
+            for (int s = firstSaved; s < savedNetworks.count(); s++) {
+                const SavedNetwork& saved = savedNetworks.get(s);
+                if (saved.channel == net.channel && saved.ssidLen == ssidLen &&
+                    memcmp(saved.ssid, ssid, ssidLen) == 0) {
+                    channelSaved = true;
+                    break;
+                }
+            }
+            if (!channelSaved) result |= TWIN_CHANNEL;
+            if (!savedNetworks.contains(net.bssid)) result |= TWIN_NOT_SAVED;
+        }
+
+        setFlags(table, i, result);
+    }
+}
+
+void TwinIndex::setFlags(const NetworkTable& table, int index, uint8_t newFlags) {
+    uint8_t added = newFlags & ~flags[index];
+    if (flags[index] && !newFlags) flagged--;
+    if (!flags[index] && newFlags) flagged++;
+    flags[index] = newFlags;
+
+    if (added && !quiet) {
+        char bssid[18];
+        char reasons[40];
+        formatBssid(table[index].bssid, bssid);
+        describe(added, reasons, sizeof(reasons));
+        Serial.print(F("Twin check: "));
+        Serial.print(table.ssidOf(table[index]));
+        Serial.print(' ');
+        Serial.print(bssid);
+        Serial.print(F(" - "));
+        Serial.println(reasons);
+    }
+}
+
+void TwinIndex::describe(uint8_t value, char* out, size_t size) {
+    static const char* const NAMES[] = { "Security", "Vendor", "Channel", "Not saved" };
+    if (size == 0) {
+        return;
+    }
+    out[0] = '\0';
+    if (value == 0) {
+        strncpy(out, "OK", size);
+        out[size - 1] = '\0';
+        return;
+    }
+    size_t used = 0;
+    for (uint8_t bit = 0; bit < sizeof(NAMES) / sizeof(NAMES[0]); bit++) {
+        if (!(value & (1 << bit))) continue;
+        int written = snprintf(out + used, size - used, "%s%s", used ? ", " : "", NAMES[bit]);
+        if (written < 0 || (size_t)written >= size - used) break;
+        used += written;
+    }
+}
@@ -0,0 +1,57 @@
+#ifndef TWIN_INDEX_H
+#define TWIN_INDEX_H
+
+#include <Arduino.h>
+#include "network_table.h"
+
+// TwinIndex::flagsOf()
+#define TWIN_SECURITY   0x01   // Open where the network is protected, or the other way round
+#define TWIN_VENDOR     0x02   // OUI from another vendor than the network's
+#define TWIN_CHANNEL    0x04   // Saved network heard on a channel it was not saved on
+#define TWIN_NOT_SAVED  0x08   // SSID is saved, this BSSID is not
+
+// Evil-twin and rogue-AP checks over a NetworkTable. Entries are chained
+// by their SsidPool id - the pool already hashes every SSID to one id -
+// so all BSSIDs advertising an SSID are one short list away. Each merged
+// sighting only re-checks its own SSID's list against that network's
+// reference: the saved networks with the SSID when there are any (the
+// allow-list), otherwise the BSSID that was seen first. Only a table
+// layout change (expiry, clear) or an edit of the saved networks rebuilds
+// the chains.
+class TwinIndex {
+public:
+    TwinIndex();
+
+    bool begin(ScanArena& arena, int capacity, int ssidSlots);
+    static size_t arenaBytes(int capacity, int ssidSlots);
+
+    void update(const NetworkTable& table, int index);   // After each merge
+    void sync(const NetworkTable& table);                // After anything else changed the table
+
+    uint8_t flagsOf(int index) const { return index >= 0 && index < entries ? flags[index] : 0; }
+    int getFlaggedCount() const { return flagged; }
+
+    // "Security, Vendor", "OK" when flags is 0
+    static void describe(uint8_t flags, char* out, size_t size);
+
+private:
+    void link(int index, uint16_t ssidId);
+    void unlink(int index);
+    void check(const NetworkTable& table, uint16_t ssidId);
+    void rebuild(const NetworkTable& table);
+    void setFlags(const NetworkTable& table, int index, uint8_t newFlags);
+
+    uint16_t* heads;      // First table index per SsidPool id
+    uint16_t* next;       // Next table index with the same SSID
+    uint16_t* linked;     // SsidPool id each entry is chained under
+    uint8_t* flags;       // TWIN_* per table entry
+    int capacity;
+    int ssidSlots;
+    int entries;          // Table entries indexed
+    int flagged;
+    uint32_t indexedLayout;
+    uint16_t savedRevision;
+    bool quiet;           // Rebuilding after a layout change - do not log
+};
+
+#endif
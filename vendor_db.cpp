@@ -0,0 +1,46 @@
+#include "vendor_db.h"
+#ifdef OUI_TABLE_HEADER
+#include OUI_TABLE_HEADER   // Host build: generated into the build tree
+#else
+#include "oui_table.h"
+#endif
+
+uint16_t vendorLookup(const uint8_t* bssid) {
+    // Locally administered addresses (randomized, mesh, guest SSIDs...)
+    // are never in the registry
+    if (bssid[0] & 0x02) {
+        return VENDOR_UNKNOWN;
+    }
+
+    uint32_t key = ((uint32_t)bssid[0] << 16) | ((uint32_t)bssid[1] << 8) | bssid[2];
+    int low = 0;
+    int high = OUI_ENTRY_COUNT - 1;
+
+    while (low <= high) {
+        int mid = (low + high) / 2;
+        const uint8_t* entry = OUI_PREFIXES + mid * 3;
+        uint32_t oui = ((uint32_t)pgm_read_byte(entry) << 16) |
+                       ((uint32_t)pgm_read_byte(entry + 1) << 8) |
+                       pgm_read_byte(entry + 2);
+        if (oui == key) {
+            return pgm_read_word(OUI_VENDOR + mid);
+        }
+        if (oui < key) {
+            low = mid + 1;
+        } else {
+            high = mid - 1;
+        }
+    }
+    return VENDOR_UNKNOWN;
+}
+
+void vendorName(uint16_t vendorId, char* out, size_t size) {
+    if (vendorId >= OUI_VENDOR_COUNT) {
+        strncpy_P(out, PSTR("Unknown"), size);
+    } else {
+        oui_name_offset_t offset;
+        memcpy_P(&offset, OUI_NAME_OFFS + vendorId, sizeof(offset));
+        strncpy_P(out, OUI_NAME_POOL + offset, size);
+    }
+    out[size - 1] = '\0';
+}
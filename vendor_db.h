@@ -0,0 +1,15 @@
+#ifndef VENDOR_DB_H
+#define VENDOR_DB_H
+
+#include <Arduino.h>
+
+#define VENDOR_UNKNOWN 0xFFFF
+
+// MAC vendor lookup against the flash-resident OUI table in oui_table.h.
+// Nothing is copied to RAM; lookups are a binary search on the raw BSSID.
+uint16_t vendorLookup(const uint8_t* bssid);
+
+// Copy a vendor's name into out, "Unknown" for VENDOR_UNKNOWN
+void vendorName(uint16_t vendorId, char* out, size_t size);
+
+#endif
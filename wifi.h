@@ -3,70 +3,69 @@
 
 #include <Wire.h>
 #include <ESP8266WiFi.h>
-#include <EEPROM.h>
 #include <Adafruit_SSD1306.h>
+#include "scan_engine.h"
+#include "network_record.h"
+#include "scan_arena.h"
+#include "network_table.h"
+#include "network_sort.h"
+#include "network_view.h"
+#include "twin_index.h"
+#include "ssid_glob.h"
+#include "screen.h"
+#include "saved_networks.h"
+#include "journal.h"
 
-// Memory management optimizations
-#define MAX_NETWORKS 5
-#define NETWORK_DATA_SIZE 150  // Max size for each network entry
-#define EEPROM_START_ADDR 0
-#define MAX_SCAN_RESULTS 20  // Maximum networks to store in memory
+class WifiMenu : public JournalClient {
+    friend class PipelineBench;  // Host benchmark, see host/bench.cpp
 
-class WifiMenu {
 public:
     WifiMenu();  // Constructor
     ~WifiMenu(); // Destructor to free memory
 
+    bool begin();  // Size the scan storage from the free heap - call from setup()
+
     // Core WiFi functions
     void scanNetworks();
+    void pollScan();
+    bool isScanning() const;
+    void setAutoRescan(bool enabled);
+    bool isAutoRescan() const;
+    const char* nextScanMode();  // Cycle probe type/dwell, returns its name
+    unsigned long getDroppedCount() const;  // APs that did not fit, in the running or last sweep
+
+    // Screens - each call pushes onto the screen stack and returns at once
     void showScannedNetworks();
     void filterNetworks();
-    void sortBySignalStrength();
+    void sortNetworks();
+    const __FlashStringHelper* nextSortKey();  // Cycle the list order, returns its name
     void showFilteredNetworks();
     void saveNetworkForDeauth(int index);
+    void saveNetworkForDeauth(const NetworkRecord& net, const char* ssid);
     int getFilteredNetworkCount() const;
-    void initializeEEPROM();
-    bool clearAllNetworks();
 
     // Network management
     bool isNetworkValid(const String& network) const;
     void showNetworkDetails(int networkIndex);
     
+    // Filters, scan mode and sort order are kept in the journal
+    void restore(uint8_t type, const uint8_t* data, uint8_t len) override;
+    void snapshot(Journal& journal) override;
+
     // Deauth functions
     void startDeauth(const String& targetBSSID, const String& targetSSID);
     void stopDeauth();
     void showDeauthScreen();
     bool isDeauthRunning() const;
     
-    // EEPROM helpers
-    String readStringFromEEPROM(int addr);
-    void writeStringToEEPROM(int addr, const String& data);
-    
-    // Saved network functions
-    int getSavedNetworkCount() const;
-    bool getSavedNetwork(int index, String &ssid, String &bssid);
-    bool deleteSavedNetwork(int index);
 
 private:
     // Utility functions
     void splitString(const String& input, char delimiter, String output[]);
-    String getMacVendor(const String& mac) const;
-    
-    // Network information structure - consolidated for better memory management
-    struct NetworkDetail {
-        String bssid;
-        int rssi;
-        int channel;
-        String encryption;
-        String authMode;
-        String isHidden;
-        String band;
-        String securityProtocol;
-        String quality;
-        String vendor;
-        String scanTime;
-        String distance;
-    };
+
+    // Scan engine plumbing
+    static void onScanResult(const ScanResult& result, void* context);
+    void addScanResult(const ScanResult& result);
     
     // Filtering system
     struct FilterSettings {
@@ -77,15 +76,114 @@ private:
         bool channel24GHz;
         bool channel5GHz;
         String ssidPattern;
+        SsidGlob ssidMatcher;   // ssidPattern, compiled
         int channelFilter;
     };
     
     // Filter-related functions
-    void showFilterMenu();
     void applyFilters();
     void resetFilters();
-    bool matchesFilters(int networkIndex) const;
-    void inputSsidPattern();
+    bool saveFilters(Journal& journal) const;
+    bool saveScanPrefs(Journal& journal) const;
+    bool matchesFilters(const NetworkRecord& net) const;
+    static bool filterPredicate(const NetworkRecord& net, const void* context);
+    int countPatternMatches(const SsidGlob& matcher) const;
+
+    // ===== Screens =====
+    // Scanned network list, follows the table live while a sweep runs
+    class ListScreen : public Screen {
+    public:
+        explicit ListScreen(WifiMenu& menu) : menu(menu) {}
+        void update(Button btn) override;
+        void render() override;
+        void onEnter() override;
+        void onExit() override;
+        void onResume(Screen* closed) override;
+
+    private:
+        WifiMenu& menu;
+        int selectedIndex;
+        int scrollOffset;
+        unsigned long lastScrollTime;
+        bool marquee;                 // Selected label is scrolling
+
+        // What the last frame showed, to spot new results and sweep progress
+        uint32_t shownVersion;
+        int shownChannels;
+        unsigned long shownDropped;
+    };
+
+    // One network, one field per page. Tracks the AP by BSSID so it stays
+    // put while background sweeps re-sort the list underneath.
+    class DetailsScreen : public Screen {
+    public:
+        explicit DetailsScreen(WifiMenu& menu) : menu(menu) {}
+        void setNetwork(const NetworkRecord& record);
+        void update(Button btn) override;
+        void render() override;
+        void onEnter() override;
+        void onExit() override;
+
+    private:
+        void refresh();
+
+        WifiMenu& menu;
+        NetworkRecord net;            // Copy - the table entry may be evicted
+        char ssid[SSID_MAX_LEN + 1];
+        uint32_t shownVersion;
+        int detailIndex;
+        bool inDeauthConfirm;
+        int scrollOffset;
+        unsigned long lastScrollTime;
+        bool marquee;
+    };
+
+    class FilterScreen : public Screen {
+    public:
+        explicit FilterScreen(WifiMenu& menu) : menu(menu) {}
+        void update(Button btn) override;
+        void render() override;
+        void onEnter() override;
+        void onResume(Screen* closed) override;
+        void onExit() override;
+
+    private:
+        void editValue(Button btn);
+        void finish();
+
+        WifiMenu& menu;
+        FilterSettings originalSettings;  // Restored on exit
+        int selectedOption;
+        bool valueEditMode;
+    };
+
+    // Character picker for the SSID pattern, with a live match count.
+    // BACK deletes, or on an empty pattern leaves it as it was; holding
+    // SELECT stores the pattern.
+    class PatternScreen : public Screen {
+    public:
+        explicit PatternScreen(WifiMenu& menu) : menu(menu) {}
+        void update(Button btn) override;
+        void render() override;
+        void onEnter() override;
+
+    private:
+        void recount();
+
+        WifiMenu& menu;
+        String pattern;
+        int selectedCharIndex;
+        SsidGlob preview;
+        int previewCount;
+        uint32_t countedVersion;
+        bool cursorShown;
+        bool addedChar;               // By the last SELECT, taken back if it was a hold
+    };
+
+    ListScreen listScreen;
+    DetailsScreen detailsScreen;
+    FilterScreen filterScreen;
+    PatternScreen patternScreen;
     
     // Deauth tracking variables
     volatile bool deauthRunning;
@@ -100,16 +198,29 @@ private:
     // Send deauth packet implementation
     void sendDeauthPacket(uint8_t *bssid, uint8_t *station, uint8_t reason);
     
-    // Network storage
-    int filteredNetworkCount;
-    String* filteredNetworks;  // Dynamic array
-    NetworkDetail* networkDetails;  // Dynamic array
+    // Network storage, all carved from one arena at boot
+    ScanArena arena;
+    NetworkTable table;       // Every AP seen so far, merged across sweeps
+    NetworkOrder order;       // Display order of the table
+    NetworkView view;         // Filtered view over the order
+    TwinIndex twins;          // Evil-twin / rogue-AP flags per table entry
     FilterSettings filterSettings;
+    ScanEngine scanner;
+    bool autoRescan;          // Start a new sweep as soon as one finishes
+    uint8_t scanMode;         // Index into SCAN_MODES
+    unsigned long nextRescanTime;
+    unsigned long dropBase;          // Drop counters at the end of the last sweep
+    unsigned long lastSweepDropped;
+    bool storageReady;        // begin() got an arena - nothing is scanned without one
     
     // UI helpers
-    void drawScrollableText(const String& text, int x, int y, int width, int& scrollOffset, 
+    bool drawScrollableText(const char* text, int x, int y, int width, int& scrollOffset, 
                            unsigned long& lastScrollTime, unsigned long scrollDelay = 200);
     void drawProgressBar(int x, int y, int width, int height, int percentage);
+    bool beginStorage(int capacity);
+    static size_t storageBytes(int capacity);
+    NetworkRecord& networkAt(int position);
+    void formatDetailValue(const NetworkRecord& net, const char* ssid, int item, char* out, size_t size) const;
 };
 
 #endif // WIFI_H
\ No newline at end of file